@@ -0,0 +1,41 @@
+/**
+ * Denormals - flush-to-zero guard for the audio loops
+ *
+ * A decaying string's tail ends up in subnormal floats, and x86 handles
+ * those in microcode at many times the cost of a normal operation: a silent
+ * string gets slower exactly when nothing is audible. DenormalGuard sets the
+ * FTZ (flush-to-zero) and DAZ (denormals-are-zero) bits of MXCSR for its
+ * scope, one render call, and restores the caller's mode afterwards.
+ *
+ * WebAssembly has no control over the floating-point mode, so the guard is a
+ * no-op there and on other architectures; the engines' idle-string sleep
+ * keeps long tails from reaching the subnormal range in the first place.
+ */
+
+#pragma once
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__EMSCRIPTEN__)
+
+#include <xmmintrin.h>
+
+class DenormalGuard {
+public:
+    DenormalGuard() : saved(_mm_getcsr()) { _mm_setcsr(saved | FTZ_DAZ); }
+    ~DenormalGuard() { _mm_setcsr(saved); }
+
+    DenormalGuard(const DenormalGuard&) = delete;
+    DenormalGuard& operator=(const DenormalGuard&) = delete;
+
+private:
+    static constexpr unsigned int FTZ_DAZ = 0x8040;  // MXCSR bits 15 (FTZ) and 6 (DAZ)
+    unsigned int saved;
+};
+
+#else
+
+class DenormalGuard {
+public:
+    DenormalGuard() {}
+};
+
+#endif
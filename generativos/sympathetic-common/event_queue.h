@@ -0,0 +1,96 @@
+/**
+ * Event Queue - sample-accurate timed events for the render loops
+ *
+ * Setters take effect when they are called, which is between blocks (or
+ * anywhere in a block, from a UI event). Scheduled events instead carry an
+ * offset in samples from the start of the next renderBlock(), and the
+ * engine applies each one right before rendering that sample:
+ *
+ *   renderBlock(256)   [0 ........ 100 ........... 180 ......... 256)
+ *                                   ^ pluck          ^ setDamping
+ *                      rendered as spans [0,100) [100,180) [180,256)
+ *
+ * Events past the end of the block stay queued and their offsets move back
+ * by the block length, so a sequencer can schedule ahead of the block it
+ * is in. Events on the same sample apply in the order they were pushed.
+ *
+ * The queue is a sorted fixed array: no allocation, push is an insertion
+ * (events mostly arrive in order, so it rarely moves anything), pop is O(1).
+ * When the queue is full, push returns false and drops the event.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+constexpr int EVENT_CAPACITY = 256;
+
+// Meaning of type / index / a / b is up to the engine
+struct TimedEvent {
+    int offset;  // Samples from the start of the next block
+    int type;
+    int index;
+    float a;
+    float b;
+};
+
+template <int Capacity = EVENT_CAPACITY>
+class EventQueue {
+public:
+    bool push(TimedEvent event) {
+        event.offset = std::max(0, event.offset);
+
+        if (first + count == Capacity) {
+            if (first == 0) return false;
+            std::copy(items.begin() + first, items.begin() + first + count, items.begin());
+            first = 0;
+        }
+
+        // After every event on or before the same sample
+        int i = first + count;
+        while (i > first && items[i - 1].offset > event.offset) {
+            items[i] = items[i - 1];
+            i--;
+        }
+        items[i] = event;
+        count++;
+        return true;
+    }
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+
+    // Offset of the earliest event (only when not empty)
+    int nextOffset() const { return items[first].offset; }
+
+    // i-th earliest event, i < size()
+    const TimedEvent& at(int i) const { return items[first + i]; }
+
+    // Takes the earliest event if it is due at or before `frame`
+    bool popDue(int frame, TimedEvent& event) {
+        if (count == 0 || items[first].offset > frame) return false;
+        event = items[first];
+        first++;
+        count--;
+        if (count == 0) first = 0;
+        return true;
+    }
+
+    // End of a block of numFrames: later events move to the next block
+    void advance(int numFrames) {
+        for (int i = first; i < first + count; i++) {
+            items[i].offset = std::max(0, items[i].offset - numFrames);
+        }
+    }
+
+    void clear() {
+        first = 0;
+        count = 0;
+    }
+
+private:
+    std::array<TimedEvent, Capacity> items;
+    int first = 0;
+    int count = 0;
+};
@@ -0,0 +1,154 @@
+/**
+ * Load Meter - DSP load of the render loops
+ *
+ * Each renderBlock is timed with the monotonic clock and compared with its
+ * real-time budget, numFrames / sampleRate: a load of 1.0 means the block
+ * took exactly as long as it lasts, and anything above is an overrun (a
+ * glitch, unless the host buffers ahead). Per block the meter keeps
+ *
+ *   - a histogram of load in LOAD_BIN_WIDTH steps (the last bin holds
+ *     everything from LOAD_BINS * LOAD_BIN_WIDTH - LOAD_BIN_WIDTH up)
+ *   - the worst load, the overrun count and the block count
+ *   - the load smoothed over LOAD_SMOOTHING_SECONDS of audio, for a meter
+ *
+ * The audio thread is the only writer; every statistic is a relaxed atomic
+ * that it updates with a plain load and store (no locked read-modify-write),
+ * so a UI or worker thread can read them at any time without locks. A
+ * reader sees each value whole, though not always all of them from the same
+ * block. reset() from another thread only raises a flag, and the writer
+ * clears the statistics before its next block.
+ *
+ * Two clock reads per block cost well under a microsecond natively. In the
+ * browser the clock is performance.now(), which is coarsened to tens of
+ * microseconds unless the page is cross-origin isolated, so short blocks
+ * read in quantized steps there.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+constexpr int LOAD_BINS = 32;
+constexpr float LOAD_BIN_WIDTH = 1.0f / 16.0f;     // Histogram covers 0 .. 2x budget
+constexpr float LOAD_SMOOTHING_SECONDS = 0.3f;
+
+class LoadMeter {
+public:
+    LoadMeter() { clear(); }
+
+    // The statistics describe the blocks of one engine instance, so a copy
+    // (forkInto, a restored snapshot) starts its own and assignment keeps
+    // the target's
+    LoadMeter(const LoadMeter&) : LoadMeter() {}
+    LoadMeter& operator=(const LoadMeter&) { return *this; }
+
+    // Times one block from construction to destruction
+    class Scope {
+    public:
+        Scope(LoadMeter& meter, int numFrames, float sampleRate)
+            : meter(meter.enabled.load(std::memory_order_relaxed) && numFrames > 0 ? &meter : nullptr),
+              budget(numFrames / sampleRate) {
+            if (this->meter) start = std::chrono::steady_clock::now();
+        }
+
+        ~Scope() {
+            if (!meter) return;
+            std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+            meter->record(elapsed.count(), budget);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        LoadMeter* meter;
+        float budget;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // ========================================================================
+    // Writer (audio thread)
+    // ========================================================================
+    void record(float seconds, float budget) {
+        if (resetPending.load(std::memory_order_acquire)) {
+            clear();
+            resetPending.store(false, std::memory_order_release);
+        }
+
+        float load = seconds / budget;
+        int bin = std::min(LOAD_BINS - 1, static_cast<int>(load / LOAD_BIN_WIDTH));
+        bump(histogram[bin]);
+        bump(blocks);
+        if (load > 1.0f) bump(overruns);
+
+        lastLoad.store(load, std::memory_order_relaxed);
+        if (load > worstLoad.load(std::memory_order_relaxed)) {
+            worstLoad.store(load, std::memory_order_relaxed);
+        }
+
+        float a = std::min(1.0f, budget / LOAD_SMOOTHING_SECONDS);
+        float smoothed = smoothedLoad.load(std::memory_order_relaxed);
+        smoothedLoad.store(smoothed + a * (load - smoothed), std::memory_order_relaxed);
+    }
+
+    // ========================================================================
+    // Queries (any thread)
+    // ========================================================================
+    float load() const { return smoothedLoad.load(std::memory_order_relaxed); }
+    float lastBlockLoad() const { return lastLoad.load(std::memory_order_relaxed); }
+    float worst() const { return worstLoad.load(std::memory_order_relaxed); }
+    uint32_t overrunCount() const { return overruns.load(std::memory_order_relaxed); }
+    uint32_t blockCount() const { return blocks.load(std::memory_order_relaxed); }
+
+    uint32_t bin(int i) const {
+        return (i >= 0 && i < LOAD_BINS) ? histogram[i].load(std::memory_order_relaxed) : 0;
+    }
+
+    // Load under which a fraction p of the blocks stayed (upper edge of the
+    // bin reaching p); 0 before the first block
+    float percentile(float p) const {
+        uint32_t total = 0;
+        uint32_t counts[LOAD_BINS];
+        for (int i = 0; i < LOAD_BINS; i++) total += counts[i] = bin(i);
+        if (total == 0) return 0.0f;
+
+        uint32_t target = static_cast<uint32_t>(std::max(0.0f, std::min(1.0f, p)) * total);
+        uint32_t seen = 0;
+        for (int i = 0; i < LOAD_BINS; i++) {
+            seen += counts[i];
+            if (seen >= std::max<uint32_t>(target, 1)) return (i + 1) * LOAD_BIN_WIDTH;
+        }
+        return LOAD_BINS * LOAD_BIN_WIDTH;
+    }
+
+    void reset() { resetPending.store(true, std::memory_order_release); }
+
+    void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32_t> histogram[LOAD_BINS];
+    std::atomic<uint32_t> blocks;
+    std::atomic<uint32_t> overruns;
+    std::atomic<float> lastLoad;
+    std::atomic<float> worstLoad;
+    std::atomic<float> smoothedLoad;
+    std::atomic<bool> resetPending{false};
+    std::atomic<bool> enabled{true};
+
+    static void bump(std::atomic<uint32_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void clear() {
+        for (auto& b : histogram) b.store(0, std::memory_order_relaxed);
+        blocks.store(0, std::memory_order_relaxed);
+        overruns.store(0, std::memory_order_relaxed);
+        lastLoad.store(0.0f, std::memory_order_relaxed);
+        worstLoad.store(0.0f, std::memory_order_relaxed);
+        smoothedLoad.store(0.0f, std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,191 @@
+/**
+ * Snapshot - versioned binary state of an engine
+ *
+ * Every snapshot starts with a small header:
+ *
+ *   magic (4 bytes)  u32 version  u32 realSize  u32 capacity
+ *
+ * where realSize and capacity pin down the engine's template instance, so
+ * a snapshot only restores into the engine it came from. The body comes
+ * next in native byte order, as raw fields and arrays.
+ *
+ * Engines describe their state once, in a transferState(io) template that
+ * runs over a SnapshotWriter to save and over a SnapshotReader to restore,
+ * so the two directions can never drift apart. io.count() reads and bounds
+ * every length or index that sizes an array or divides, io.divisor() every
+ * step stride that must divide a cycle, and io.flag() every bool (one byte,
+ * 0 or 1; any other byte would be an invalid bool). io.expect() checks that
+ * the data a count announces is really there before anything is allocated
+ * for it. A short, foreign or
+ * out-of-range snapshot makes the reader fail instead of writing outside an
+ * array or running a state the engine cannot reach.
+ *
+ * The writer works into a caller buffer (a null buffer only measures),
+ * so checkpoints in a render loop need no allocation.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+#include "event_queue.h"
+
+class SnapshotWriter {
+public:
+    static constexpr bool reading = false;
+
+    SnapshotWriter(uint8_t* out, size_t capacity) : out(out), capacity(capacity) {}
+
+    template <typename T>
+    void value(T& v) { array(&v, 1); }
+
+    template <typename T>
+    void array(T* v, size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "raw fields only");
+        static_assert(!std::is_same<T, bool>::value, "bools go through flag()");
+        size_t bytes = n * sizeof(T);
+        if (out && used + bytes <= capacity) std::memcpy(out + used, v, bytes);
+        overflow |= out && used + bytes > capacity;
+        used += bytes;
+    }
+
+    bool count(int& n, int, int) {
+        value(n);
+        return true;
+    }
+
+    bool divisor(int& n, int) {
+        value(n);
+        return true;
+    }
+
+    bool expect(size_t) { return true; }
+
+    void flag(bool& b) {
+        uint8_t byte = b ? 1 : 0;
+        value(byte);
+    }
+
+    bool header(const char* magic, uint32_t version, uint32_t realSize, uint32_t cap) {
+        array(const_cast<char*>(magic), 4);
+        value(version);
+        value(realSize);
+        value(cap);
+        return true;
+    }
+
+    size_t size() const { return used; }
+    bool ok() const { return !overflow; }
+
+private:
+    uint8_t* out;
+    size_t capacity;
+    size_t used = 0;
+    bool overflow = false;
+};
+
+class SnapshotReader {
+public:
+    static constexpr bool reading = true;
+
+    SnapshotReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    void value(T& v) { array(&v, 1); }
+
+    template <typename T>
+    void array(T* v, size_t n) {
+        static_assert(std::is_trivially_copyable<T>::value, "raw fields only");
+        static_assert(!std::is_same<T, bool>::value, "bools go through flag()");
+        size_t bytes = n * sizeof(T);
+        if (failed || bytes > size - used) {
+            failed = true;
+            return;
+        }
+        std::memcpy(v, data + used, bytes);
+        used += bytes;
+    }
+
+    // A length or index in [min, max]; fails (and sets n = min) otherwise
+    bool count(int& n, int min, int max) {
+        value(n);
+        if (failed || n < min || n > max) {
+            failed = true;
+            n = min;
+        }
+        return !failed;
+    }
+
+    // A power of two dividing `cycle` (a power of two itself); fails (and
+    // sets n = 1) otherwise
+    bool divisor(int& n, int cycle) {
+        value(n);
+        if (failed || n < 1 || n > cycle || (n & (n - 1)) != 0 || cycle % n != 0) {
+            failed = true;
+            n = 1;
+        }
+        return !failed;
+    }
+
+    // Fails unless at least `bytes` are left, so a count read just before
+    // can be trusted to size an allocation
+    bool expect(size_t bytes) {
+        if (bytes > size - used) failed = true;
+        return !failed;
+    }
+
+    // A bool stored as one byte; fails on anything but 0 or 1
+    void flag(bool& b) {
+        uint8_t byte = 0;
+        value(byte);
+        if (byte > 1) failed = true;
+        b = byte == 1;
+    }
+
+    bool header(const char* magic, uint32_t version, uint32_t realSize, uint32_t cap) {
+        char m[4];
+        uint32_t v = 0, r = 0, c = 0;
+        array(m, 4);
+        value(v);
+        value(r);
+        value(c);
+        if (std::memcmp(m, magic, 4) != 0 || v != version || r != realSize || c != cap) {
+            failed = true;
+        }
+        return !failed;
+    }
+
+    // Everything read and nothing left over
+    bool ok() const { return !failed && used == size; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t used = 0;
+    bool failed = false;
+};
+
+// Pending events of an EventQueue, in order
+template <typename Io, int Capacity>
+inline void transferEvents(Io& io, EventQueue<Capacity>& events) {
+    int n = events.size();
+    if (!io.count(n, 0, Capacity)) return;
+
+    if (Io::reading) {
+        events.clear();
+        for (int i = 0; i < n; i++) {
+            TimedEvent e;
+            io.value(e);
+            events.push(e);
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            TimedEvent e = events.at(i);
+            io.value(e);
+        }
+    }
+}
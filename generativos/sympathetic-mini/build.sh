@@ -18,6 +18,8 @@ em++ src/main.cpp \
     -s EXPORT_NAME="createSympathyModule" \
     -s ALLOW_MEMORY_GROWTH=1 \
     -s ENVIRONMENT='web' \
+    -s EXPORTED_FUNCTIONS='["_malloc","_free"]' \
+    -s EXPORTED_RUNTIME_METHODS='["HEAPF32"]' \
     -lembind \
     -O3 \
     --no-entry
@@ -0,0 +1,43 @@
+/**
+ * Karplus-Strong Kernels - native runtime dispatch
+ *
+ * Only compiled into native x86-64 builds (see sympathetic-native/build.sh).
+ */
+
+#include "ks_kernels.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+const KarplusKernels* findKarplusKernels(const char* name) {
+    // __builtin_cpu_supports reads cpuid (and the OS-enabled XSAVE state)
+    __builtin_cpu_init();
+
+    if (std::strcmp(name, "scalar") == 0) {
+        return &SCALAR_KARPLUS_KERNELS;
+    }
+    if (std::strcmp(name, "avx2") == 0) {
+        return __builtin_cpu_supports("avx2") ? &AVX2_KARPLUS_KERNELS : nullptr;
+    }
+    if (std::strcmp(name, "avx512") == 0) {
+        return __builtin_cpu_supports("avx512f") ? &AVX512_KARPLUS_KERNELS : nullptr;
+    }
+    return nullptr;
+}
+
+static const KarplusKernels& selectKarplusKernels() {
+    if (const char* forced = std::getenv("SYMPATHETIC_KERNELS")) {
+        if (const KarplusKernels* kernels = findKarplusKernels(forced)) return *kernels;
+    }
+
+    for (const char* name : {"avx512", "avx2"}) {
+        if (const KarplusKernels* kernels = findKarplusKernels(name)) return *kernels;
+    }
+    return SCALAR_KARPLUS_KERNELS;
+}
+
+const KarplusKernels& activeKarplusKernels() {
+    static const KarplusKernels& kernels = selectKarplusKernels();
+    return kernels;
+}
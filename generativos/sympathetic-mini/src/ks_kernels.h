@@ -0,0 +1,74 @@
+/**
+ * Karplus-Strong Kernels - feedback loop of the delay-line strings
+ *
+ * A string reads the sample written delayLength samples ago, so any run of
+ * up to delayLength samples only depends on values already in the delay
+ * line. That run can be computed with vector instructions:
+ *
+ *   out[i] = clamp((in[i] + in[i-1]) * 0.5 * feedback + excitation[i])
+ *
+ * where in[-1] is the previous sample (the lowpass state). Vector versions
+ * evaluate the same operations in the same order (no FMA) and map NaN to 0
+ * like the scalar code, so all tables are bit-identical:
+ *   - scalar: reference, also used by the WebAssembly build
+ *   - avx2 / avx512: native x86-64 builds, picked at startup from cpuid
+ */
+
+#pragma once
+
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__EMSCRIPTEN__)
+#define KARPLUS_NATIVE_DISPATCH 1
+#else
+#define KARPLUS_NATIVE_DISPATCH 0
+#endif
+
+struct KarplusKernels {
+    const char* name;
+
+    // Lowpass + feedback + excitation + clamp for n samples; in[-1] must be valid
+    void (*feedback)(const float* in, const float* excitation, float feedback,
+                     float* out, int n);
+};
+
+// ============================================================================
+// Scalar reference
+// ============================================================================
+inline void karplusFeedbackScalar(const float* in, const float* excitation, float feedback,
+                                  float* out, int n) {
+    for (int i = 0; i < n; i++) {
+        float filtered = (in[i] + in[i-1]) * 0.5f;
+        float newSample = filtered * feedback + excitation[i];
+
+        if (newSample > 1.0f) newSample = 1.0f;
+        if (newSample < -1.0f) newSample = -1.0f;
+        if (!std::isfinite(newSample)) newSample = 0.0f;
+
+        out[i] = newSample;
+    }
+}
+
+inline constexpr KarplusKernels SCALAR_KARPLUS_KERNELS = { "scalar", karplusFeedbackScalar };
+
+#if KARPLUS_NATIVE_DISPATCH
+
+extern const KarplusKernels AVX2_KARPLUS_KERNELS;    // ks_kernels_avx2.cpp
+extern const KarplusKernels AVX512_KARPLUS_KERNELS;  // ks_kernels_avx512.cpp
+
+// Best table this CPU supports, chosen once from cpuid. The environment
+// variable SYMPATHETIC_KERNELS=scalar|avx2|avx512 overrides the choice.
+const KarplusKernels& activeKarplusKernels();
+
+// Table by name, or nullptr when unknown or unsupported on this CPU
+const KarplusKernels* findKarplusKernels(const char* name);
+
+#else
+
+inline const KarplusKernels& activeKarplusKernels() { return SCALAR_KARPLUS_KERNELS; }
+
+inline const KarplusKernels* findKarplusKernels(const char* name) {
+    return __builtin_strcmp(name, "scalar") == 0 ? &SCALAR_KARPLUS_KERNELS : nullptr;
+}
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * Karplus-Strong Kernels - AVX2 (8 samples per instruction)
+ *
+ * Compiled with -mavx2 and called only after cpuid reports AVX2 support.
+ */
+
+#include "ks_kernels.h"
+
+#include <immintrin.h>
+
+static void karplusFeedbackAvx2(const float* in, const float* excitation, float feedback,
+                                float* out, int n) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 fb = _mm256_set1_ps(feedback);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 minusOne = _mm256_set1_ps(-1.0f);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 cur = _mm256_loadu_ps(in + i);
+        __m256 prev = _mm256_loadu_ps(in + i - 1);
+        __m256 exc = _mm256_loadu_ps(excitation + i);
+
+        __m256 filtered = _mm256_mul_ps(_mm256_add_ps(cur, prev), half);
+        __m256 s = _mm256_add_ps(_mm256_mul_ps(filtered, fb), exc);
+
+        // NaN -> 0; min/max would otherwise turn it into a rail
+        __m256 ordered = _mm256_cmp_ps(s, s, _CMP_ORD_Q);
+        s = _mm256_min_ps(_mm256_max_ps(s, minusOne), one);
+        _mm256_storeu_ps(out + i, _mm256_and_ps(s, ordered));
+    }
+
+    karplusFeedbackScalar(in + i, excitation + i, feedback, out + i, n - i);
+}
+
+const KarplusKernels AVX2_KARPLUS_KERNELS = { "avx2", karplusFeedbackAvx2 };
@@ -0,0 +1,37 @@
+/**
+ * Karplus-Strong Kernels - AVX-512 (16 samples per instruction)
+ *
+ * Compiled with -mavx512f and called only after cpuid reports AVX-512F
+ * support. Tails use masked loads/stores.
+ */
+
+#include "ks_kernels.h"
+
+#include <immintrin.h>
+
+static void karplusFeedbackAvx512(const float* in, const float* excitation, float feedback,
+                                  float* out, int n) {
+    const __m512 half = _mm512_set1_ps(0.5f);
+    const __m512 fb = _mm512_set1_ps(feedback);
+    const __m512 one = _mm512_set1_ps(1.0f);
+    const __m512 minusOne = _mm512_set1_ps(-1.0f);
+
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 m = (n - i >= 16) ? __mmask16(0xFFFF)
+                                    : static_cast<__mmask16>((1u << (n - i)) - 1u);
+
+        __m512 cur = _mm512_maskz_loadu_ps(m, in + i);
+        __m512 prev = _mm512_maskz_loadu_ps(m, in + i - 1);
+        __m512 exc = _mm512_maskz_loadu_ps(m, excitation + i);
+
+        __m512 filtered = _mm512_mul_ps(_mm512_add_ps(cur, prev), half);
+        __m512 s = _mm512_add_ps(_mm512_mul_ps(filtered, fb), exc);
+
+        // NaN -> 0; min/max would otherwise turn it into a rail
+        __mmask16 ordered = _mm512_cmp_ps_mask(s, s, _CMP_ORD_Q);
+        s = _mm512_min_ps(_mm512_max_ps(s, minusOne), one);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_maskz_mov_ps(ordered, s));
+    }
+}
+
+const KarplusKernels AVX512_KARPLUS_KERNELS = { "avx512", karplusFeedbackAvx512 };
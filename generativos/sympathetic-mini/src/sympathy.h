@@ -0,0 +1,542 @@
+/**
+ * Sympathetic Mini - Minimal 4-string sympathetic resonance synthesizer
+ *
+ * Purpose: Debug and understand sympathetic resonance behavior
+ * Strings: C4, E4, G4, B4 (major 7th chord)
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "ks_kernels.h"
+#include "../../sympathetic-common/denormals.h"
+#include "../../sympathetic-common/event_queue.h"
+#include "../../sympathetic-common/snapshot.h"
+#include "../../sympathetic-common/load_meter.h"
+
+constexpr float SAMPLE_RATE = 44100.0f;
+constexpr int NUM_STRINGS = 4;
+constexpr int MAX_DELAY = 2048;
+constexpr float SLEEP_LEVEL = 1e-5f;  // Level under which a silent string sleeps (-100 dB)
+constexpr uint32_t MINI_SNAPSHOT_VERSION = 1;
+
+// Frequencies for C4, E4, G4, B4
+const float FREQUENCIES[NUM_STRINGS] = {
+    261.63f,  // C4
+    329.63f,  // E4
+    392.00f,  // G4
+    493.88f   // B4
+};
+
+// Interval coupling matrix (4x4)
+// Based on semitone intervals: C-E=4, C-G=7, C-B=11, E-G=3, E-B=7, G-B=4
+const float COUPLING[NUM_STRINGS][NUM_STRINGS] = {
+    // C     E     G     B
+    {1.0f, 0.4f, 0.6f, 0.2f},  // C: unison, M3, P5, M7
+    {0.4f, 1.0f, 0.3f, 0.6f},  // E: M3, unison, m3, P5
+    {0.6f, 0.3f, 1.0f, 0.4f},  // G: P5, m3, unison, M3
+    {0.2f, 0.6f, 0.4f, 1.0f}   // B: M7, P5, M3, unison
+};
+
+//=============================================================================
+// Simple Karplus-Strong String
+//=============================================================================
+class String {
+public:
+    float delayLine[MAX_DELAY] = {0};
+    int writePos = 0;
+    int delayLength = 0;
+    float feedback = 0.995f;
+    float prevSample = 0.0f;  // For simple lowpass
+    float energy = 0.0f;
+    uint32_t noiseState = 12345;
+    bool asleep = false;  // Silent: delay line zeroed, not processed (see SympathyMini)
+
+    void setFrequency(float freq) {
+        delayLength = static_cast<int>(SAMPLE_RATE / freq);
+        if (delayLength > MAX_DELAY - 1) delayLength = MAX_DELAY - 1;
+        if (delayLength < 2) delayLength = 2;
+    }
+
+    void pluck(float velocity) {
+        // Fill delay line with noise
+        for (int i = 0; i < delayLength; i++) {
+            float noise = nextNoise() * velocity;
+            int pos = (writePos + MAX_DELAY - i) % MAX_DELAY;
+            delayLine[pos] = noise;
+        }
+        energy = velocity;
+        asleep = false;
+    }
+
+    float process(float excitation) {
+        asleep = false;  // Writing the line wakes a sleeping string
+
+        // Read from delay line
+        int readPos = (writePos + MAX_DELAY - delayLength) % MAX_DELAY;
+        float sample = delayLine[readPos];
+
+        // Simple lowpass filter (average with previous)
+        float filtered = (sample + prevSample) * 0.5f;
+        prevSample = sample;
+
+        // Apply feedback
+        float feedbackSample = filtered * feedback;
+
+        // Add external excitation (sympathetic resonance)
+        float newSample = feedbackSample + excitation;
+
+        // Safety clamp
+        if (newSample > 1.0f) newSample = 1.0f;
+        if (newSample < -1.0f) newSample = -1.0f;
+        if (!std::isfinite(newSample)) newSample = 0.0f;
+
+        // Write to delay line
+        delayLine[writePos] = newSample;
+
+        // Advance write position
+        writePos = (writePos + 1) % MAX_DELAY;
+
+        trackEnergy(sample);
+
+        return sample;
+    }
+
+    // Peak follower with slow release, fed with every output sample
+    void trackEnergy(float sample) {
+        energy = energy * 0.9995f;
+        if (std::abs(sample) > energy) energy = std::abs(sample);
+    }
+
+    // ------------------------------------------------------------------------
+    // Block access (n <= delayLength)
+    // ------------------------------------------------------------------------
+    // The next n output samples are already in the delay line. peek() copies
+    // them to dst[0..n-1] and the lowpass state to dst[-1]; commit() writes
+    // the n new samples computed from them and advances.
+    void peek(float* dst, int n) const {
+        dst[-1] = prevSample;
+        int readPos = (writePos + MAX_DELAY - delayLength) % MAX_DELAY;
+        int first = std::min(n, MAX_DELAY - readPos);
+        std::memcpy(dst, delayLine + readPos, first * sizeof(float));
+        std::memcpy(dst + first, delayLine, (n - first) * sizeof(float));
+    }
+
+    void commit(const float* samples, const float* read, int n) {
+        int first = std::min(n, MAX_DELAY - writePos);
+        std::memcpy(delayLine + writePos, samples, first * sizeof(float));
+        std::memcpy(delayLine, samples + first, (n - first) * sizeof(float));
+        writePos = (writePos + n) % MAX_DELAY;
+        prevSample = read[n - 1];
+    }
+
+    float getEnergy() const { return energy; }
+
+    // Zeroes the string; its output stays 0 until it is plucked or written
+    // again, so it can be skipped meanwhile
+    void sleep() {
+        std::memset(delayLine, 0, sizeof(delayLine));
+        prevSample = 0.0f;
+        energy = 0.0f;
+        asleep = true;
+    }
+
+private:
+    float nextNoise() {
+        noiseState = noiseState * 1103515245 + 12345;
+        return (static_cast<float>(noiseState) / static_cast<float>(UINT32_MAX)) * 2.0f - 1.0f;
+    }
+};
+
+//=============================================================================
+// Sympathetic Mini Synth
+//=============================================================================
+class SympathyMini {
+public:
+    String strings[NUM_STRINGS];
+    float stringOutputs[NUM_STRINGS] = {0};
+    float excitationAccum[NUM_STRINGS] = {0};  // Smoothed excitation
+    float sympathyAmount = 0.3f;
+    float masterVolume = 0.7f;
+
+    // Tunable parameters
+    float gateThreshold = 0.01f;   // Min energy to excite others
+    float excitationDecay = 0.9f;  // How fast excitation fades
+    float couplingScale = 0.03f;   // Strength of coupling
+
+    // Delay-line feedback loop (scalar / AVX2 / AVX-512)
+    const KarplusKernels* kernels = &activeKarplusKernels();
+
+    // Plucks and parameter changes scheduled inside upcoming blocks
+    EventQueue<> events;
+
+    // Time of every renderBlock against its real-time budget (see DSP Load)
+    LoadMeter loadMeter;
+
+    SympathyMini() {
+        for (int i = 0; i < NUM_STRINGS; i++) {
+            strings[i].setFrequency(FREQUENCIES[i]);
+        }
+    }
+
+    void pluck(int stringIndex, float velocity) {
+        if (stringIndex >= 0 && stringIndex < NUM_STRINGS) {
+            strings[stringIndex].pluck(velocity);
+        }
+    }
+
+    void setSympatheticAmount(float amount) {
+        sympathyAmount = std::max(0.0f, std::min(1.0f, amount));
+    }
+
+    void setMasterVolume(float vol) {
+        masterVolume = std::max(0.0f, std::min(1.0f, vol));
+    }
+
+    void setGateThreshold(float val) {
+        gateThreshold = std::max(0.0f, std::min(0.1f, val));
+    }
+
+    void setExcitationDecay(float val) {
+        excitationDecay = std::max(0.5f, std::min(0.999f, val));
+    }
+
+    void setCouplingScale(float val) {
+        couplingScale = std::max(0.001f, std::min(0.2f, val));
+    }
+
+    // ========================================================================
+    // Scheduled Events
+    // ========================================================================
+    // Same as pluck / the setters, applied right before sample `offset` of
+    // the next renderBlock (later offsets carry over to later blocks, see
+    // event_queue.h). Returns false when the queue is full.
+    enum EventType {
+        PLUCK_EVENT, SYMPATHY_EVENT, VOLUME_EVENT, GATE_EVENT, DECAY_EVENT, COUPLING_EVENT
+    };
+
+    bool schedulePluck(int offset, int stringIndex, float velocity) {
+        return events.push({offset, PLUCK_EVENT, stringIndex, velocity, 0.0f});
+    }
+    bool scheduleSympatheticAmount(int offset, float amount) {
+        return events.push({offset, SYMPATHY_EVENT, 0, amount, 0.0f});
+    }
+    bool scheduleMasterVolume(int offset, float vol) {
+        return events.push({offset, VOLUME_EVENT, 0, vol, 0.0f});
+    }
+    bool scheduleGateThreshold(int offset, float val) {
+        return events.push({offset, GATE_EVENT, 0, val, 0.0f});
+    }
+    bool scheduleExcitationDecay(int offset, float val) {
+        return events.push({offset, DECAY_EVENT, 0, val, 0.0f});
+    }
+    bool scheduleCouplingScale(int offset, float val) {
+        return events.push({offset, COUPLING_EVENT, 0, val, 0.0f});
+    }
+
+    void clearEvents() { events.clear(); }
+    int getPendingEvents() const { return events.size(); }
+
+    // ========================================================================
+    // Block Rendering
+    // ========================================================================
+    // Splits the block into chunks no longer than the shortest delay line, so
+    // every string's output for the chunk is known up front. The coupling and
+    // mix run per sample; the delay-line feedback runs as one vector kernel
+    // per string (see ks_kernels.h). Awake, this matches per-sample
+    // processing exactly.
+    //
+    // A string whose level is under SLEEP_LEVEL, and whose incoming
+    // excitation could not ring it up past SLEEP_LEVEL either, is put to
+    // sleep at the end of a chunk: zeroed, and its delay line no longer read
+    // or written. The loop adds excitation at its pitch up coherently, to
+    // 1 / (1 - feedback) times its size (200x), so the excitation floor is
+    // that much lower (wakeLevel). Sleep is lossy: it truncates the tail
+    // still in the line and the pending excitation, both under those floors
+    // (-100 dB), and that difference carries into whatever the string plays
+    // next (a pluck refills only delayLength samples). Excitation from the
+    // others wakes it, its delay line holding zeros for the time it slept,
+    // as does a pluck. With every string asleep and no excitation left, a
+    // block is just silence.
+    //
+    // Scheduled events split the block into spans and apply at their sample.
+    void renderBlock(int numFrames, float* outL, float* outR) {
+        LoadMeter::Scope timing(loadMeter, numFrames, SAMPLE_RATE);
+        DenormalGuard guard;
+
+        int done = 0;
+        while (done < numFrames) {
+            TimedEvent event;
+            while (events.popDue(done, event)) applyEvent(event);
+
+            int end = events.empty() ? numFrames : std::min(numFrames, events.nextOffset());
+            renderSpan(end - done, outL + done, outR + done);
+            done = end;
+        }
+        events.advance(numFrames);
+    }
+
+    std::vector<float> process(int numSamples) {
+        std::vector<float> output(numSamples * 2, 0.0f);  // Stereo
+        scratchL.resize(numSamples);
+        scratchR.resize(numSamples);
+
+        renderBlock(numSamples, scratchL.data(), scratchR.data());
+
+        for (int i = 0; i < numSamples; i++) {
+            output[i * 2] = scratchL[i];
+            output[i * 2 + 1] = scratchR[i];
+        }
+
+        return output;
+    }
+
+    // ========================================================================
+    // DSP Load
+    // ========================================================================
+    // Render time over real time of the renderBlock calls, process()
+    // included (load_meter.h). Safe to read from any thread.
+    float getDspLoad() const { return loadMeter.load(); }
+    float getWorstDspLoad() const { return loadMeter.worst(); }
+    float getDspLoadPercentile(float p) const { return loadMeter.percentile(p); }
+    int getOverruns() const { return static_cast<int>(loadMeter.overrunCount()); }
+    int getTimedBlocks() const { return static_cast<int>(loadMeter.blockCount()); }
+    int getLoadHistogram(int bin) const { return static_cast<int>(loadMeter.bin(bin)); }
+    void resetLoadStats() { loadMeter.reset(); }
+    void setLoadMetering(bool enabled) { loadMeter.setEnabled(enabled); }
+
+    // ========================================================================
+    // Snapshots
+    // ========================================================================
+    // Whole synth state as bytes (format in snapshot.h): delay lines, write
+    // positions, filter and noise state, excitation, parameters and pending
+    // events. saveState returns the size, or 0 if `capacity` is too small.
+    size_t snapshotSize() const {
+        SnapshotWriter w(nullptr, 0);
+        const_cast<SympathyMini*>(this)->transferState(w);
+        return w.size();
+    }
+
+    size_t saveState(uint8_t* out, size_t capacity) const {
+        SnapshotWriter w(out, capacity);
+        const_cast<SympathyMini*>(this)->transferState(w);
+        return w.ok() ? w.size() : 0;
+    }
+
+    std::vector<uint8_t> saveState() const {
+        std::vector<uint8_t> out(snapshotSize());
+        saveState(out.data(), out.size());
+        return out;
+    }
+
+    // On a malformed snapshot returns false and leaves a fresh synth
+    bool restoreState(const uint8_t* data, size_t size) {
+        SnapshotReader r(data, size);
+        transferState(r);
+        if (!r.ok()) {
+            *this = SympathyMini();
+            return false;
+        }
+        return true;
+    }
+
+    // Copies the synth state into another instance (no allocation)
+    void forkInto(SympathyMini& slot) const {
+        if (&slot == this) return;
+        std::copy(std::begin(strings), std::end(strings), std::begin(slot.strings));
+        std::copy(std::begin(stringOutputs), std::end(stringOutputs), std::begin(slot.stringOutputs));
+        std::copy(std::begin(excitationAccum), std::end(excitationAccum),
+                  std::begin(slot.excitationAccum));
+        slot.sympathyAmount = sympathyAmount;
+        slot.masterVolume = masterVolume;
+        slot.gateThreshold = gateThreshold;
+        slot.excitationDecay = excitationDecay;
+        slot.couplingScale = couplingScale;
+        slot.events = events;
+    }
+
+    template <typename Io>
+    void transferState(Io& io) {
+        if (!io.header("SMIN", MINI_SNAPSHOT_VERSION, sizeof(float), MAX_DELAY)) return;
+
+        for (String& s : strings) {
+            io.array(s.delayLine, MAX_DELAY);
+            io.count(s.writePos, 0, MAX_DELAY - 1);
+            io.count(s.delayLength, 2, MAX_DELAY - 1);
+            io.value(s.feedback);
+            io.value(s.prevSample);
+            io.value(s.energy);
+            io.value(s.noiseState);
+            io.flag(s.asleep);
+        }
+        io.array(stringOutputs, NUM_STRINGS);
+        io.array(excitationAccum, NUM_STRINGS);
+
+        io.value(sympathyAmount);
+        io.value(masterVolume);
+        io.value(gateThreshold);
+        io.value(excitationDecay);
+        io.value(couplingScale);
+
+        transferEvents(io, events);
+    }
+
+    std::vector<float> getEnergies() {
+        std::vector<float> energies(NUM_STRINGS);
+        for (int i = 0; i < NUM_STRINGS; i++) {
+            energies[i] = strings[i].getEnergy();
+        }
+        return energies;
+    }
+
+private:
+    static constexpr int MAX_CHUNK = 256;
+
+    float readBuf[NUM_STRINGS][MAX_CHUNK + 1];  // [0] holds the lowpass state
+    float excitationBuf[NUM_STRINGS][MAX_CHUNK];
+    float writeBuf[MAX_CHUNK];
+    std::vector<float> scratchL, scratchR;
+
+    void applyEvent(const TimedEvent& e) {
+        switch (e.type) {
+            case PLUCK_EVENT: pluck(e.index, e.a); break;
+            case SYMPATHY_EVENT: setSympatheticAmount(e.a); break;
+            case VOLUME_EVENT: setMasterVolume(e.a); break;
+            case GATE_EVENT: setGateThreshold(e.a); break;
+            case DECAY_EVENT: setExcitationDecay(e.a); break;
+            case COUPLING_EVENT: setCouplingScale(e.a); break;
+        }
+    }
+
+    // numFrames frames with no event inside
+    void renderSpan(int numFrames, float* outL, float* outR) {
+        if (silent()) {
+            std::fill(outL, outL + numFrames, 0.0f);
+            std::fill(outR, outR + numFrames, 0.0f);
+            return;
+        }
+
+        int done = 0;
+        while (done < numFrames) {
+            int chunk = std::min(numFrames - done, MAX_CHUNK);
+            for (int s = 0; s < NUM_STRINGS; s++) {
+                chunk = std::min(chunk, strings[s].delayLength);
+            }
+            renderChunk(chunk, outL + done, outR + done);
+            done += chunk;
+        }
+    }
+
+    bool silent() const {
+        for (int s = 0; s < NUM_STRINGS; s++) {
+            if (!strings[s].asleep || excitationAccum[s] != 0.0f) return false;
+        }
+        return true;
+    }
+
+    void renderChunk(int n, float* outL, float* outR) {
+        for (int s = 0; s < NUM_STRINGS; s++) {
+            if (strings[s].asleep) {
+                std::fill(readBuf[s], readBuf[s] + n + 1, 0.0f);
+            } else {
+                strings[s].peek(readBuf[s] + 1, n);
+            }
+        }
+
+        // Scale for sympathetic coupling
+        float scale = sympathyAmount * couplingScale;
+        float blend = 1.0f - excitationDecay;
+
+        for (int i = 0; i < n; i++) {
+            // Calculate sympathetic excitation for each string
+            float excitation[NUM_STRINGS] = {0};
+
+            for (int src = 0; src < NUM_STRINGS; src++) {
+                // GATE: Only excite if source has real energy
+                float srcEnergy = strings[src].getEnergy();
+                if (srcEnergy < gateThreshold) continue;
+
+                for (int tgt = 0; tgt < NUM_STRINGS; tgt++) {
+                    if (src != tgt) {
+                        excitation[tgt] += stringOutputs[src] * COUPLING[src][tgt] * scale;
+                    }
+                }
+            }
+
+            // Smooth excitation with configurable decay
+            for (int s = 0; s < NUM_STRINGS; s++) {
+                excitationAccum[s] = excitationAccum[s] * excitationDecay + excitation[s] * blend;
+
+                // Clamp
+                if (excitationAccum[s] > 0.1f) excitationAccum[s] = 0.1f;
+                if (excitationAccum[s] < -0.1f) excitationAccum[s] = -0.1f;
+
+                excitationBuf[s][i] = excitationAccum[s];
+            }
+
+            // Each string outputs the sample it reads from its delay line
+            float left = 0.0f, right = 0.0f;
+            for (int s = 0; s < NUM_STRINGS; s++) {
+                stringOutputs[s] = readBuf[s][i + 1];
+                strings[s].trackEnergy(stringOutputs[s]);
+
+                // Simple stereo pan (spread across stereo field)
+                float pan = static_cast<float>(s) / (NUM_STRINGS - 1);  // 0 to 1
+                left += stringOutputs[s] * (1.0f - pan);
+                right += stringOutputs[s] * pan;
+            }
+
+            // Apply master volume
+            left *= masterVolume;
+            right *= masterVolume;
+
+            // Soft clip
+            if (left > 0.95f) left = 0.95f + std::tanh(left - 0.95f) * 0.05f;
+            if (left < -0.95f) left = -0.95f + std::tanh(left + 0.95f) * 0.05f;
+            if (right > 0.95f) right = 0.95f + std::tanh(right - 0.95f) * 0.05f;
+            if (right < -0.95f) right = -0.95f + std::tanh(right + 0.95f) * 0.05f;
+
+            outL[i] = left;
+            outR[i] = right;
+        }
+
+        // Feed the chunk back into every awake (or waking) delay line
+        for (int s = 0; s < NUM_STRINGS; s++) {
+            String& str = strings[s];
+            bool driven = peakLevel(excitationBuf[s], n) >= wakeLevel(str);
+            if (str.asleep) {
+                if (!driven) {
+                    excitationAccum[s] = 0.0f;  // Drops excitation under wakeLevel
+                    continue;
+                }
+                str.asleep = false;
+            }
+
+            kernels->feedback(readBuf[s] + 1, excitationBuf[s], str.feedback, writeBuf, n);
+            str.commit(writeBuf, readBuf[s] + 1, n);
+
+            // Truncates the tail (see renderBlock)
+            if (!driven && str.getEnergy() < SLEEP_LEVEL) {
+                str.sleep();
+                excitationAccum[s] = 0.0f;
+                stringOutputs[s] = 0.0f;
+            }
+        }
+    }
+
+    // Excitation that rings a string up to SLEEP_LEVEL at its pitch
+    static float wakeLevel(const String& str) {
+        return SLEEP_LEVEL * (1.0f - str.feedback);
+    }
+
+    static float peakLevel(const float* x, int n) {
+        float peak = 0.0f;
+        for (int i = 0; i < n; i++) peak = std::max(peak, std::abs(x[i]));
+        return peak;
+    }
+};
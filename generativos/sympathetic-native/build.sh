@@ -0,0 +1,75 @@
+#!/bin/bash
+
+# Native (Linux / x86-64) build of the Sympathetic Strings and Sympathetic
+# Mini engines, without Emscripten. Produces static libraries holding the
+# runtime-dispatched SIMD kernels; the engines themselves are header-only.
+#
+#   ./build.sh            # g++
+#   CXX=clang++ ./build.sh
+
+set -e
+
+cd "$(dirname "$0")"
+
+CXX=${CXX:-g++}
+STRINGS=../sympathetic-strings/src
+MINI=../sympathetic-mini/src
+OUT=build
+
+# -ffp-contract=off keeps scalar and vector kernels bit-identical: the
+# AVX-512 units would otherwise fuse multiply-adds in their scalar tails
+CXXFLAGS=(-std=c++17 -O3 -ffp-contract=off -Wall -Wextra -fPIC)
+
+# GCC's own AVX-512 intrinsic headers trip -Wuninitialized (_mm512_undefined_ps)
+AVX512=(-mavx512f -Wno-uninitialized -Wno-maybe-uninitialized)
+
+echo "Building native engines..."
+
+mkdir -p "$OUT/obj"
+
+# Sympathetic Strings: dispatch + one object per instruction set
+$CXX "${CXXFLAGS[@]}" -c "$STRINGS/stencil_kernels.cpp" -o "$OUT/obj/stencil_kernels.o"
+$CXX "${CXXFLAGS[@]}" -mavx2 -c "$STRINGS/stencil_kernels_avx2.cpp" -o "$OUT/obj/stencil_kernels_avx2.o"
+$CXX "${CXXFLAGS[@]}" "${AVX512[@]}" -c "$STRINGS/stencil_kernels_avx512.cpp" -o "$OUT/obj/stencil_kernels_avx512.o"
+ar rcs "$OUT/libsympathetic_strings.a" \
+    "$OUT/obj/stencil_kernels.o" \
+    "$OUT/obj/stencil_kernels_avx2.o" \
+    "$OUT/obj/stencil_kernels_avx512.o"
+
+# Sympathetic Mini
+$CXX "${CXXFLAGS[@]}" -c "$MINI/ks_kernels.cpp" -o "$OUT/obj/ks_kernels.o"
+$CXX "${CXXFLAGS[@]}" -mavx2 -c "$MINI/ks_kernels_avx2.cpp" -o "$OUT/obj/ks_kernels_avx2.o"
+$CXX "${CXXFLAGS[@]}" "${AVX512[@]}" -c "$MINI/ks_kernels_avx512.cpp" -o "$OUT/obj/ks_kernels_avx512.o"
+ar rcs "$OUT/libsympathy_mini.a" \
+    "$OUT/obj/ks_kernels.o" \
+    "$OUT/obj/ks_kernels_avx2.o" \
+    "$OUT/obj/ks_kernels_avx512.o"
+
+# Tools
+$CXX "${CXXFLAGS[@]}" -pthread -I"$STRINGS" tools/sweep.cpp "$OUT/libsympathetic_strings.a" \
+    -o "$OUT/sympathetic-sweep"
+
+# The engines share constant names, so each gets its own adapter object
+$CXX "${CXXFLAGS[@]}" -I"$STRINGS" -c tools/render_strings.cpp -o "$OUT/obj/render_strings.o"
+$CXX "${CXXFLAGS[@]}" -I"$MINI" -c tools/render_mini.cpp -o "$OUT/obj/render_mini.o"
+$CXX "${CXXFLAGS[@]}" tools/render.cpp "$OUT/obj/render_strings.o" "$OUT/obj/render_mini.o" \
+    "$OUT/libsympathetic_strings.a" "$OUT/libsympathy_mini.a" -o "$OUT/sympathetic-render"
+
+$CXX "${CXXFLAGS[@]}" -I"$STRINGS" -c tools/bench_strings.cpp -o "$OUT/obj/bench_strings.o"
+$CXX "${CXXFLAGS[@]}" -I"$MINI" -c tools/bench_mini.cpp -o "$OUT/obj/bench_mini.o"
+$CXX "${CXXFLAGS[@]}" tools/bench.cpp "$OUT/obj/bench_strings.o" "$OUT/obj/bench_mini.o" \
+    "$OUT/libsympathetic_strings.a" "$OUT/libsympathy_mini.a" -o "$OUT/sympathetic-bench"
+
+$CXX "${CXXFLAGS[@]}" -I"$STRINGS" -c tools/equiv_strings.cpp -o "$OUT/obj/equiv_strings.o"
+$CXX "${CXXFLAGS[@]}" -I"$MINI" -c tools/equiv_mini.cpp -o "$OUT/obj/equiv_mini.o"
+$CXX "${CXXFLAGS[@]}" tools/equiv.cpp "$OUT/obj/equiv_strings.o" "$OUT/obj/equiv_mini.o" \
+    "$OUT/libsympathetic_strings.a" "$OUT/libsympathy_mini.a" -o "$OUT/sympathetic-equiv"
+
+echo "Build complete! Output in $OUT/"
+echo "  - libsympathetic_strings.a  (include $STRINGS/physics.h, string_bank.h,"
+echo "                               modal_strings.h, waveguide_strings.h)"
+echo "  - libsympathy_mini.a        (include $MINI/sympathy.h)"
+echo "  - sympathetic-sweep         (parameter sweeps, see README.md)"
+echo "  - sympathetic-render        (offline WAV rendering, see README.md)"
+echo "  - sympathetic-bench         (microbenchmarks, see README.md)"
+echo "  - sympathetic-equiv         (kernel equivalence, see README.md)"
@@ -0,0 +1,305 @@
+/**
+ * Sympathetic Bench - microbenchmarks of both engines
+ *
+ * Runs the cases of bench_strings.cpp and bench_mini.cpp (stepOnce,
+ * renderBlock, computeEnergy and pluck of SympatheticStrings, StringBank
+ * sizes, String::process, SympathyMini::process) and reports per case:
+ *
+ *   ns/op         per call of the function under test
+ *   ns/substep    per base physics step (dt = 1 / (44100 * 8))
+ *   ns/sample     per output frame
+ *   samples/s     output frames per second
+ *   allocs/block  operator new calls per renderBlock / process call
+ *
+ * Every repeat builds its case afresh from the same fixed state and the
+ * median repeat is reported, after one untimed warm-up. Allocations are
+ * counted by replacing every global operator new of this program; direct
+ * malloc / aligned_alloc calls are not seen (see Allocation counting).
+ *
+ *   sympathetic-bench --out bench.json
+ *   sympathetic-bench --baseline bench.json --threshold 0.1
+ *
+ * Results go out as JSON. Against a baseline (an earlier --out file), a
+ * case regresses when its ns/op grows by more than the threshold or it
+ * allocates more per run; any regression makes the exit status 2.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "json_reader.h"
+
+constexpr int BENCH_VERSION = 1;
+
+volatile float benchSink = 0.0f;
+
+// ============================================================================
+// Allocation counting
+// ============================================================================
+// Every replaceable operator new (plain, array, aligned, nothrow) counts.
+// C allocations (malloc, std::aligned_alloc) cannot be replaced portably and
+// are not counted: StringBank's AlignedFloats allocates that way, but only
+// when it is built or resized, never per block.
+static int64_t allocations = 0;
+
+static void* allocate(size_t size, size_t align) {
+    allocations++;
+    size = size ? size : 1;
+    if (align <= alignof(std::max_align_t)) return std::malloc(size);
+    return std::aligned_alloc(align, (size + align - 1) / align * align);  // Size a multiple of align
+}
+
+static void* allocateOrThrow(size_t size, size_t align) {
+    if (void* p = allocate(size, align)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(size_t size, std::align_val_t a) { return allocateOrThrow(size, static_cast<size_t>(a)); }
+void* operator new[](size_t size, std::align_val_t a) { return allocateOrThrow(size, static_cast<size_t>(a)); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(a));
+}
+void* operator new[](size_t size, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(a));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+// ============================================================================
+// Running
+// ============================================================================
+struct BenchResult {
+    std::string name;
+    BenchWork work;
+    double seconds = 0.0;  // Median run
+    int64_t allocs = 0;    // Per run
+
+    double nsPer(int64_t count) const { return count > 0 ? seconds * 1e9 / count : 0.0; }
+};
+
+static BenchResult runCase(const BenchCase& c, int repeats) {
+    c.make()();  // Warm-up: caches, kernel dispatch, page faults
+
+    std::vector<double> times;
+    times.reserve(repeats);
+    BenchResult result;
+    result.name = c.name;
+    for (int r = 0; r < repeats; r++) {
+        BenchRun run = c.make();
+
+        int64_t before = allocations;
+        auto start = std::chrono::steady_clock::now();
+        BenchWork work = run();
+        auto end = std::chrono::steady_clock::now();
+        result.allocs = std::max(result.allocs, allocations - before);
+
+        result.work = work;
+        times.push_back(std::chrono::duration<double>(end - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    result.seconds = times[times.size() / 2];
+    return result;
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+// A metric, or null where the count does not apply
+static void jsonMetric(FILE* f, const char* key, double value, bool applies) {
+    if (applies) std::fprintf(f, ", \"%s\": %.6g", key, value);
+    else std::fprintf(f, ", \"%s\": null", key);
+}
+
+static bool writeJson(FILE* f, const std::vector<BenchResult>& results, int repeats) {
+    std::fprintf(f, "{\"version\": %d, \"strings_kernels\": \"%s\", \"mini_kernels\": \"%s\", "
+                    "\"repeat\": %d,\n \"results\": [\n",
+                 BENCH_VERSION, stringsKernelName(), miniKernelName(), repeats);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        const BenchWork& w = r.work;
+        std::fprintf(f, "  {\"name\": \"%s\"", r.name.c_str());
+        jsonMetric(f, "ns_per_op", r.nsPer(w.ops), true);
+        jsonMetric(f, "ns_per_substep", r.nsPer(w.substeps), w.substeps > 0);
+        jsonMetric(f, "ns_per_sample", r.nsPer(w.samples), w.samples > 0);
+        jsonMetric(f, "samples_per_second", w.samples / r.seconds, w.samples > 0);
+        jsonMetric(f, "allocs_per_block", static_cast<double>(r.allocs) / w.blocks, w.blocks > 0);
+        std::fprintf(f, ", \"allocs\": %lld, \"ops\": %lld, \"substeps\": %lld, \"samples\": %lld, "
+                        "\"blocks\": %lld}%s\n",
+                     static_cast<long long>(r.allocs), static_cast<long long>(w.ops),
+                     static_cast<long long>(w.substeps), static_cast<long long>(w.samples),
+                     static_cast<long long>(w.blocks), i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, " ]}\n");
+    return !std::ferror(f);
+}
+
+static void printRow(const BenchResult& r) {
+    const BenchWork& w = r.work;
+    std::fprintf(stderr, "%-36s %11.1f", r.name.c_str(), r.nsPer(w.ops));
+    if (w.substeps > 0) std::fprintf(stderr, " %11.2f", r.nsPer(w.substeps));
+    else std::fprintf(stderr, " %11s", "-");
+    if (w.samples > 0) std::fprintf(stderr, " %11.1f %12.0f", r.nsPer(w.samples), w.samples / r.seconds);
+    else std::fprintf(stderr, " %11s %12s", "-", "-");
+    if (w.blocks > 0) std::fprintf(stderr, " %8.2f\n", static_cast<double>(r.allocs) / w.blocks);
+    else std::fprintf(stderr, " %8s\n", "-");
+}
+
+// ============================================================================
+// Baseline comparison
+// ============================================================================
+// Number of regressions against the baseline file, or -1 if it is unusable
+static int compareBaseline(const std::string& path, const std::vector<BenchResult>& results,
+                           double threshold) {
+    std::string text;
+    Json root;
+    if (!readFile(path, text) || !JsonParser(text).parse(root) || !root.get("results")) {
+        std::fprintf(stderr, "sympathetic-bench: %s: not a benchmark file\n", path.c_str());
+        return -1;
+    }
+
+    const Json* kernels = root.get("strings_kernels");
+    if (kernels && kernels->text != stringsKernelName()) {
+        std::fprintf(stderr, "warning: baseline ran the %s kernels, this run %s\n",
+                     kernels->text.c_str(), stringsKernelName());
+    }
+
+    std::fprintf(stderr, "\n%-36s %11s %11s %8s\n", "vs baseline", "base ns/op", "ns/op", "change");
+    int regressions = 0;
+    for (const BenchResult& r : results) {
+        const Json* base = nullptr;
+        for (const Json& b : root.get("results")->items) {
+            const Json* name = b.get("name");
+            if (name && name->text == r.name) base = &b;
+        }
+        if (!base || !base->get("ns_per_op")) {
+            std::fprintf(stderr, "%-36s %11s %11.1f %8s\n", r.name.c_str(), "-", r.nsPer(r.work.ops), "new");
+            continue;
+        }
+
+        double before = base->get("ns_per_op")->number;
+        double now = r.nsPer(r.work.ops);
+        double change = before > 0.0 ? now / before - 1.0 : 0.0;
+        const Json* baseAllocs = base->get("allocs");
+        bool slower = change > threshold;
+        bool allocates = baseAllocs && r.allocs > baseAllocs->number;
+
+        std::fprintf(stderr, "%-36s %11.1f %11.1f %+7.1f%%%s%s\n", r.name.c_str(), before, now,
+                     100.0 * change, slower ? "  REGRESSION" : "",
+                     allocates ? "  MORE ALLOCATIONS" : "");
+        regressions += slower || allocates;
+    }
+    return regressions;
+}
+
+// ============================================================================
+// Command line
+// ============================================================================
+struct BenchConfig {
+    std::string filter;
+    std::string out;         // JSON file; stdout if empty
+    std::string baseline;
+    double threshold = 0.10;
+    int repeats = 5;
+    bool list = false;
+};
+
+static void usage() {
+    std::fprintf(stderr,
+        "usage: sympathetic-bench [options]\n"
+        "  --filter TEXT       only cases whose name contains TEXT\n"
+        "  --repeat N          timed runs per case, median reported (default 5)\n"
+        "  --out FILE          JSON results (default: stdout)\n"
+        "  --baseline FILE     compare with an earlier --out file\n"
+        "  --threshold F       allowed slowdown against the baseline (default 0.10)\n"
+        "  --list              list the cases and exit\n");
+}
+
+static bool parseArgs(int argc, char** argv, BenchConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--list") {
+            config.list = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        const char* value = argv[++i];
+
+        if (arg == "--filter") config.filter = value;
+        else if (arg == "--repeat") config.repeats = std::atoi(value);
+        else if (arg == "--out") config.out = value;
+        else if (arg == "--baseline") config.baseline = value;
+        else if (arg == "--threshold") config.threshold = std::strtod(value, nullptr);
+        else return false;
+    }
+    return config.repeats >= 1 && config.threshold >= 0.0;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        usage();
+        return 1;
+    }
+
+    std::vector<BenchCase> cases;
+    addStringsBenchmarks(cases);
+    addMiniBenchmarks(cases);
+    cases.erase(std::remove_if(cases.begin(), cases.end(), [&](const BenchCase& c) {
+        return c.name.find(config.filter) == std::string::npos;
+    }), cases.end());
+
+    if (config.list) {
+        for (const BenchCase& c : cases) std::printf("%s\n", c.name.c_str());
+        return 0;
+    }
+
+    std::fprintf(stderr, "kernels: strings %s, mini %s\n", stringsKernelName(), miniKernelName());
+    std::fprintf(stderr, "%-36s %11s %11s %11s %12s %8s\n",
+                 "case", "ns/op", "ns/substep", "ns/sample", "samples/s", "allocs/b");
+    std::vector<BenchResult> results;
+    for (const BenchCase& c : cases) {
+        results.push_back(runCase(c, config.repeats));
+        printRow(results.back());
+    }
+
+    FILE* f = config.out.empty() ? stdout : std::fopen(config.out.c_str(), "w");
+    bool written = f && writeJson(f, results, config.repeats);
+    if (f && f != stdout) written &= std::fclose(f) == 0;
+    if (!written) {
+        std::fprintf(stderr, "sympathetic-bench: cannot write %s\n", config.out.c_str());
+        return 1;
+    }
+
+    if (config.baseline.empty()) return 0;
+    int regressions = compareBaseline(config.baseline, results, config.threshold);
+    if (regressions < 0) return 1;
+    std::fprintf(stderr, "%d regression%s (threshold %.0f%%)\n", regressions,
+                 regressions == 1 ? "" : "s", 100.0 * config.threshold);
+    return regressions > 0 ? 2 : 0;
+}
@@ -0,0 +1,45 @@
+/**
+ * Bench - benchmark cases of sympathetic-bench
+ *
+ * A case builds its engine in a fixed state (fixed frequencies, plucks and
+ * noise seeds, no clocks or randomness) and returns a run: a closure doing
+ * one timed batch of work and reporting how much it did. The harness
+ * (bench.cpp) builds a fresh case for every repeat, so every repeat starts
+ * from the same state and the setup stays outside the timing.
+ *
+ * As with the renderer, physics.h and sympathy.h cannot share a translation
+ * unit, so each engine registers its cases from its own file
+ * (bench_strings.cpp, bench_mini.cpp).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// What one run did; zero where a count does not apply
+struct BenchWork {
+    int64_t ops = 0;       // Calls of the function under test
+    int64_t substeps = 0;  // Base physics steps (stepOnce, dt = 1 / (44100 * 8))
+    int64_t samples = 0;   // Output frames
+    int64_t blocks = 0;    // Block calls (renderBlock / process)
+};
+
+using BenchRun = std::function<BenchWork()>;
+
+struct BenchCase {
+    std::string name;               // "engine/function/scenario"
+    std::function<BenchRun()> make;
+};
+
+void addStringsBenchmarks(std::vector<BenchCase>& cases);
+void addMiniBenchmarks(std::vector<BenchCase>& cases);
+
+// Cases store a result here so the work cannot be optimized away
+extern volatile float benchSink;
+
+// Kernel tables in use, recorded with the results
+const char* stringsKernelName();
+const char* miniKernelName();
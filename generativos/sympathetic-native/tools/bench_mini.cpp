@@ -0,0 +1,92 @@
+/**
+ * SympathyMini cases for sympathetic-bench (see bench.h)
+ *
+ *   mini/String::process/F   one Karplus-Strong string, per sample, fed a
+ *                            fixed-seed excitation
+ *   mini/process/bN          SympathyMini::process in blocks of N frames
+ *                            (allocates its interleaved output)
+ *   mini/renderBlock/bN      the same audio through renderBlock
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "sympathy.h"
+
+constexpr int STRING_SAMPLES = 44100;  // Samples per String::process run (1 s)
+constexpr int MINI_FRAMES = 44100;     // Frames per block run (1 s)
+
+static const float STRING_FREQUENCIES[] = { 110.0f, 329.63f, 987.77f };
+static const int MINI_BLOCKS[] = { 32, 128, 512, 2048 };
+
+// Every string plucked, as after a strum
+static std::shared_ptr<SympathyMini> strummed() {
+    auto synth = std::make_shared<SympathyMini>();
+    for (int s = 0; s < NUM_STRINGS; s++) synth->pluck(s, 0.8f - 0.1f * s);
+    return synth;
+}
+
+void addMiniBenchmarks(std::vector<BenchCase>& cases) {
+    for (float freq : STRING_FREQUENCIES) {
+        cases.push_back({"mini/String::process/" + std::to_string(static_cast<int>(freq)), [freq] {
+            auto string = std::make_shared<String>();
+            string->setFrequency(freq);
+            string->pluck(0.8f);
+            return BenchRun([string] {
+                uint32_t seed = 1;
+                float sum = 0.0f;
+                for (int i = 0; i < STRING_SAMPLES; i++) {
+                    seed = seed * 1664525u + 1013904223u;
+                    float excitation = (static_cast<int32_t>(seed) >> 8) * 1e-10f;
+                    sum += string->process(excitation);
+                }
+                benchSink = sum;
+
+                BenchWork w;
+                w.ops = w.samples = STRING_SAMPLES;
+                return w;
+            });
+        }});
+    }
+
+    for (int block : MINI_BLOCKS) {
+        cases.push_back({"mini/process/b" + std::to_string(block), [block] {
+            auto synth = strummed();
+            return BenchRun([synth, block] {
+                BenchWork w;
+                float sum = 0.0f;
+                for (int done = 0; done < MINI_FRAMES; done += block) {
+                    sum += synth->process(block)[0];
+                    w.blocks++;
+                }
+                benchSink = sum;
+
+                w.ops = w.blocks;
+                w.samples = w.blocks * block;
+                return w;
+            });
+        }});
+
+        cases.push_back({"mini/renderBlock/b" + std::to_string(block), [block] {
+            auto synth = strummed();
+            auto out = std::make_shared<std::vector<float>>(2 * block);
+            return BenchRun([synth, out, block] {
+                BenchWork w;
+                for (int done = 0; done < MINI_FRAMES; done += block) {
+                    synth->renderBlock(block, out->data(), out->data() + block);
+                    w.blocks++;
+                }
+                w.ops = w.blocks;
+                w.samples = w.blocks * block;
+                return w;
+            });
+        }});
+    }
+}
+
+const char* miniKernelName() {
+    return activeKarplusKernels().name;
+}
@@ -0,0 +1,140 @@
+/**
+ * SympatheticStrings and StringBank cases for sympathetic-bench (see bench.h)
+ *
+ *   strings/stepOnce/F1-F2/pN     base steps at a frequency pair and grid
+ *                                 capacity (110-440 runs the strings at
+ *                                 different substep rates)
+ *   strings/renderBlock/F1-F2/bN  audio in blocks of N frames
+ *   strings/computeEnergy/pN      energy of one string
+ *   strings/pluck/pN              triangular pluck of one string
+ *   bank/renderBlock/sN           StringBank of N strings, 256-frame blocks
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "string_bank.h"
+
+constexpr int STEP_COUNT = 44100 * OVERSAMPLING / 4;  // Base steps per run (0.25 s)
+constexpr int RENDER_FRAMES = 11025;                  // Frames per render run (0.25 s)
+constexpr int BANK_FRAMES = 4410;                     // Frames per bank run (0.1 s)
+constexpr int BANK_BLOCK = 256;
+constexpr int ENERGY_CALLS = 20000;
+constexpr int PLUCK_CALLS = 20000;
+
+struct FrequencyPair {
+    float f1, f2;
+    const char* label;
+};
+
+static const FrequencyPair PAIRS[] = {
+    {220.0f, 330.0f, "220-330"},   // Fifth, same stride
+    {110.0f, 440.0f, "110-440"},   // Two octaves, multi-rate
+    {440.0f, 880.0f, "440-880"},   // High pair, coarse grids
+};
+
+static const int RENDER_BLOCKS[] = { 16, 64, 256, 1024 };
+static const int BANK_SIZES[] = { 2, 8, 32, 128 };
+
+// Both strings plucked at a fixed pair
+template <int Points>
+static std::shared_ptr<BasicSympatheticStrings<float, Points>> pluckedPair(const FrequencyPair& pair) {
+    auto sim = std::make_shared<BasicSympatheticStrings<float, Points>>();
+    sim->setString1Frequency(pair.f1);
+    sim->setString2Frequency(pair.f2);
+    sim->pluck(0, 0.3f, 0.5f);
+    sim->pluck(1, 0.7f, 0.3f);
+    return sim;
+}
+
+template <int Points>
+static void addResolution(std::vector<BenchCase>& cases) {
+    const std::string p = "/p" + std::to_string(Points);
+
+    for (const FrequencyPair& pair : PAIRS) {
+        cases.push_back({"strings/stepOnce/" + std::string(pair.label) + p, [pair] {
+            auto sim = pluckedPair<Points>(pair);
+            return BenchRun([sim] {
+                sim->step(STEP_COUNT);
+                BenchWork w;
+                w.ops = w.substeps = STEP_COUNT;
+                return w;
+            });
+        }});
+    }
+
+    cases.push_back({"strings/computeEnergy" + p, [] {
+        auto sim = pluckedPair<Points>(PAIRS[0]);
+        return BenchRun([sim] {
+            for (int i = 0; i < ENERGY_CALLS; i++) sim->computeEnergy(sim->string1);
+            BenchWork w;
+            w.ops = ENERGY_CALLS;
+            return w;
+        });
+    }});
+
+    cases.push_back({"strings/pluck" + p, [] {
+        auto sim = pluckedPair<Points>(PAIRS[0]);
+        return BenchRun([sim] {
+            for (int i = 0; i < PLUCK_CALLS; i++) sim->pluck(i & 1, 0.3f, 0.5f);
+            BenchWork w;
+            w.ops = PLUCK_CALLS;
+            return w;
+        });
+    }});
+}
+
+void addStringsBenchmarks(std::vector<BenchCase>& cases) {
+    addResolution<64>(cases);
+    addResolution<NUM_POINTS>(cases);
+    addResolution<512>(cases);
+
+    for (const FrequencyPair& pair : PAIRS) {
+        for (int block : RENDER_BLOCKS) {
+            std::string name = "strings/renderBlock/" + std::string(pair.label) + "/b" + std::to_string(block);
+            cases.push_back({name, [pair, block] {
+                auto sim = pluckedPair<NUM_POINTS>(pair);
+                auto out = std::make_shared<std::vector<float>>(2 * block);
+                return BenchRun([sim, out, block] {
+                    BenchWork w;
+                    for (int done = 0; done < RENDER_FRAMES; done += block) {
+                        sim->renderBlock(block, 0.3f, out->data(), out->data() + block);
+                        w.blocks++;
+                    }
+                    w.ops = w.blocks;
+                    w.samples = w.blocks * block;
+                    w.substeps = w.samples * OVERSAMPLING;
+                    return w;
+                });
+            }});
+        }
+    }
+
+    for (int strings : BANK_SIZES) {
+        cases.push_back({"bank/renderBlock/s" + std::to_string(strings), [strings] {
+            auto bank = std::make_shared<StringBank>(strings);
+            for (int k = 0; k < strings; k++) {
+                bank->setFrequency(k, 110.0f * (1.0f + 0.25f * (k % 12)));
+                bank->pluck(k, 0.2f + 0.05f * (k % 10), 0.3f);
+            }
+            auto out = std::make_shared<std::vector<float>>(2 * BANK_BLOCK);
+            return BenchRun([bank, out] {
+                BenchWork w;
+                for (int done = 0; done < BANK_FRAMES; done += BANK_BLOCK) {
+                    bank->renderBlock(BANK_BLOCK, 0.3f, out->data(), out->data() + BANK_BLOCK);
+                    w.blocks++;
+                }
+                w.ops = w.blocks;
+                w.samples = w.blocks * BANK_BLOCK;
+                w.substeps = w.samples * OVERSAMPLING;
+                return w;
+            });
+        }});
+    }
+}
+
+const char* stringsKernelName() {
+    return activeStencilKernels().name;
+}
@@ -0,0 +1,346 @@
+/**
+ * Sympathetic Equiv - optimized paths against the scalar reference
+ *
+ * Plays one long scripted session (plucks, retunes, parameter changes, from
+ * a seed) through each engine's scalar reference and through every
+ * optimized variant (see equiv_strings.cpp, equiv_mini.cpp), and compares
+ * the output of every frame and the bridge and energies at every block end.
+ *
+ *   sympathetic-equiv                       # both engines, 30 s, block 64
+ *   sympathetic-equiv --engine strings --seconds 300 --ulp 0
+ *
+ * A value matches when it is within --ulp units in the last place of the
+ * reference, or when the difference is under --db decibels: below full
+ * scale for output, bridge and string levels, below the reference's peak
+ * of that value for energies. The default --db is the suite's: the
+ * references never sleep, so it leaves room for the tails sleep drops.
+ * The report gives each variant's largest error and the first value
+ * outside the tolerance, with its time and the last scripted event before
+ * it. Any divergence makes the exit status 2.
+ *
+ * The mini reference goes through String::process, so a rewrite of it
+ * needs a reference from before the change. --save-reference writes the
+ * reference trace of one engine, and --reference compares against such a
+ * file instead of running it:
+ *
+ *   "SEQV"  u32 version  u32 seed  f64 seconds  u32 block  u32 quantities
+ *   u64 frames  u64 blocks  engine (8 bytes, zero-padded)
+ *   left, right (frames float32 each), per-block values (blocks * quantities)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "equiv.h"
+
+constexpr uint32_t EQUIV_VERSION = 1;
+
+struct Tolerance {
+    int64_t ulp = 4;
+    double db = -1.0;  // < 0: the suite's default
+};
+
+// ============================================================================
+// Comparison
+// ============================================================================
+// Distance in representable floats (0 for +0 / -0, huge across NaN)
+static int64_t ulpDistance(float a, float b) {
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b) ? 0 : std::numeric_limits<int64_t>::max();
+    }
+    int32_t ia, ib;
+    std::memcpy(&ia, &a, 4);
+    std::memcpy(&ib, &b, 4);
+    // Sign-magnitude to a monotonic integer line
+    int64_t la = ia < 0 ? static_cast<int64_t>(INT32_MIN) - ia : ia;
+    int64_t lb = ib < 0 ? static_cast<int64_t>(INT32_MIN) - ib : ib;
+    return la > lb ? la - lb : lb - la;
+}
+
+struct Divergence {
+    bool found = false;
+    int64_t frame = 0;
+    std::string quantity;
+    float reference = 0.0f;
+    float value = 0.0f;
+    int64_t ulp = 0;
+    double db = 0.0;
+};
+
+struct Comparison {
+    int64_t maxUlp = 0;
+    double worstDb = -std::numeric_limits<double>::infinity();
+    std::string worstQuantity;
+    Divergence first;
+
+    // level: full scale of the value (1 for output)
+    void check(float ref, float got, double level, const char* quantity, int64_t frame,
+               const Tolerance& tol) {
+        int64_t ulp = ulpDistance(ref, got);
+        if (ulp == 0) return;
+
+        double diff = std::fabs(static_cast<double>(got) - ref);
+        double db = (level > 0.0 && std::isfinite(diff)) ? 20.0 * std::log10(diff / level)
+                                                         : std::numeric_limits<double>::infinity();
+        maxUlp = std::max(maxUlp, ulp);
+        if (db > worstDb) {
+            worstDb = db;
+            worstQuantity = quantity;
+        }
+
+        if (first.found || ulp <= tol.ulp || db <= -tol.db) return;
+        first = {true, frame, quantity, ref, got, ulp, db};
+    }
+};
+
+static Comparison compareTraces(const EquivSuite& suite, const EquivSession& session,
+                                const Trace& ref, const Trace& got, const Tolerance& tol) {
+    Comparison c;
+    const int64_t frames = std::min<int64_t>(ref.left.size(), got.left.size());
+    const size_t q = suite.quantities.size();
+    const int64_t blocks = std::min(ref.perBlock.size(), got.perBlock.size()) / q;
+
+    // Full scale of each block quantity
+    std::vector<double> level(q, 1.0);
+    for (size_t i = 0; i < q; i++) {
+        if (!suite.quantities[i].relative) continue;
+        level[i] = 0.0;
+        for (int64_t b = 0; b < blocks; b++) {
+            level[i] = std::max(level[i], std::fabs(static_cast<double>(ref.perBlock[b * q + i])));
+        }
+    }
+
+    // In time order, so the first divergence is the earliest one
+    int64_t frame = 0;
+    for (int64_t b = 0; b < blocks; b++) {
+        int64_t end = std::min(frames, (b + 1) * session.block);
+        for (; frame < end; frame++) {
+            c.check(ref.left[frame], got.left[frame], 1.0, "left", frame, tol);
+            c.check(ref.right[frame], got.right[frame], 1.0, "right", frame, tol);
+        }
+        for (size_t i = 0; i < q; i++) {
+            c.check(ref.perBlock[b * q + i], got.perBlock[b * q + i], level[i],
+                    suite.quantities[i].name, end - 1, tol);
+        }
+    }
+    if (ref.left.size() != got.left.size() && !c.first.found) {
+        c.first = {true, frames, "length", 0.0f, 0.0f, 0, 0.0};
+    }
+    return c;
+}
+
+// ============================================================================
+// Reference files
+// ============================================================================
+struct TraceHeader {
+    uint32_t version;
+    uint32_t seed;
+    double seconds;
+    uint32_t block;
+    uint32_t quantities;
+    uint64_t frames;
+    uint64_t blocks;
+    char engine[8];
+};
+
+static TraceHeader headerFor(const EquivSuite& suite, const EquivSession& session, const Trace& trace) {
+    TraceHeader h = {};
+    h.version = EQUIV_VERSION;
+    h.seed = session.seed;
+    h.seconds = session.seconds;
+    h.block = static_cast<uint32_t>(session.block);
+    h.quantities = static_cast<uint32_t>(suite.quantities.size());
+    h.frames = trace.left.size();
+    h.blocks = trace.perBlock.size() / suite.quantities.size();
+    std::memcpy(h.engine, suite.engine.data(), std::min(suite.engine.size(), sizeof(h.engine)));
+    return h;
+}
+
+static bool saveTrace(const std::string& path, const EquivSuite& suite, const EquivSession& session,
+                      const Trace& trace) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    TraceHeader h = headerFor(suite, session, trace);
+    bool ok = std::fwrite("SEQV", 1, 4, f) == 4
+           && std::fwrite(&h, sizeof(h), 1, f) == 1
+           && std::fwrite(trace.left.data(), sizeof(float), h.frames, f) == h.frames
+           && std::fwrite(trace.right.data(), sizeof(float), h.frames, f) == h.frames
+           && std::fwrite(trace.perBlock.data(), sizeof(float), trace.perBlock.size(), f) == trace.perBlock.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+// Fails unless the file holds this engine and session
+static bool loadTrace(const std::string& path, const EquivSuite& suite, const EquivSession& session,
+                      Trace& trace) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+
+    char magic[4];
+    TraceHeader h;
+    bool ok = std::fread(magic, 1, 4, f) == 4 && std::memcmp(magic, "SEQV", 4) == 0
+           && std::fread(&h, sizeof(h), 1, f) == 1;
+
+    Trace expected;
+    expected.left.resize(session.frames());
+    expected.perBlock.resize(session.blocks() * suite.quantities.size());
+    TraceHeader want = headerFor(suite, session, expected);
+    ok = ok && std::memcmp(&h, &want, sizeof(h)) == 0;
+
+    if (ok) {
+        trace.left.resize(h.frames);
+        trace.right.resize(h.frames);
+        trace.perBlock.resize(h.blocks * h.quantities);
+        ok = std::fread(trace.left.data(), sizeof(float), h.frames, f) == h.frames
+          && std::fread(trace.right.data(), sizeof(float), h.frames, f) == h.frames
+          && std::fread(trace.perBlock.data(), sizeof(float), trace.perBlock.size(), f) == trace.perBlock.size();
+    }
+    std::fclose(f);
+    return ok;
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+// Last scripted event at or before a frame, for context
+static const EquivEvent* eventBefore(const std::vector<EquivEvent>& events, int64_t frame) {
+    const EquivEvent* last = nullptr;
+    for (const EquivEvent& e : events) {
+        if (e.frame > frame) break;
+        last = &e;
+    }
+    return last;
+}
+
+static void report(const EquivVariant& variant, const Comparison& c, const std::vector<EquivEvent>& events) {
+    if (c.first.found) {
+        const Divergence& d = c.first;
+        std::printf("  %-22s DIVERGED at %.6f s (frame %lld) in %s: reference %.9g, got %.9g (%lld ulp, %.1f dB)\n",
+                    variant.name.c_str(), d.frame / 44100.0, static_cast<long long>(d.frame),
+                    d.quantity.c_str(), d.reference, d.value, static_cast<long long>(d.ulp), d.db);
+        if (const EquivEvent* e = eventBefore(events, d.frame)) {
+            std::printf("  %-22s last event: %s at %.6f s\n", "", e->text.c_str(), e->frame / 44100.0);
+        }
+    } else if (c.maxUlp == 0) {
+        std::printf("  %-22s identical\n", variant.name.c_str());
+    } else {
+        std::printf("  %-22s within tolerance: max %lld ulp, worst %.1f dB (%s)\n", variant.name.c_str(),
+                    static_cast<long long>(c.maxUlp), c.worstDb, c.worstQuantity.c_str());
+    }
+}
+
+// ============================================================================
+// Command line
+// ============================================================================
+struct EquivConfig {
+    std::string engine = "all";
+    std::string variant;         // Substring filter
+    std::string saveReference;
+    std::string loadReference;
+    EquivSession session;
+    Tolerance tolerance;
+};
+
+static void usage() {
+    std::fprintf(stderr,
+        "usage: sympathetic-equiv [options]\n"
+        "  --engine E            strings, mini or all (default all)\n"
+        "  --seconds S           session length (default 30)\n"
+        "  --block N             render block in frames (default 64)\n"
+        "  --seed N              script seed (default 1)\n"
+        "  --ulp N               allowed ulp distance (default 4)\n"
+        "  --db D                allowed difference, dB under full scale or the\n"
+        "                        reference's peak (default per engine)\n"
+        "  --variant TEXT        only variants whose name contains TEXT\n"
+        "  --save-reference F    write the reference trace (one engine)\n"
+        "  --reference F         compare against a saved trace (one engine)\n");
+}
+
+static bool parseArgs(int argc, char** argv, EquivConfig& config) {
+    // Every option takes a value
+    if (argc % 2 == 0) return false;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        const char* value = argv[i + 1];
+
+        if (arg == "--engine") config.engine = value;
+        else if (arg == "--seconds") config.session.seconds = std::strtod(value, nullptr);
+        else if (arg == "--block") config.session.block = std::atoi(value);
+        else if (arg == "--seed") config.session.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--ulp") config.tolerance.ulp = std::atoll(value);
+        else if (arg == "--db") config.tolerance.db = std::max(0.0, std::strtod(value, nullptr));
+        else if (arg == "--variant") config.variant = value;
+        else if (arg == "--save-reference") config.saveReference = value;
+        else if (arg == "--reference") config.loadReference = value;
+        else return false;
+    }
+    bool oneEngine = config.engine == "strings" || config.engine == "mini";
+    bool files = !config.saveReference.empty() || !config.loadReference.empty();
+    return (oneEngine || config.engine == "all") && (!files || oneEngine)
+        && config.session.seconds > 0.0 && config.session.block >= 1 && config.tolerance.ulp >= 0;
+}
+
+int main(int argc, char** argv) {
+    EquivConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        usage();
+        return 1;
+    }
+
+    std::vector<EquivSuite> suites;
+    if (config.engine != "mini") suites.push_back(stringsSuite());
+    if (config.engine != "strings") suites.push_back(miniSuite());
+
+    const EquivSession& session = config.session;
+    bool diverged = false;
+    for (const EquivSuite& suite : suites) {
+        const std::vector<EquivEvent> events = suite.script(session);
+        auto start = std::chrono::steady_clock::now();
+
+        Trace reference;
+        if (!config.loadReference.empty()) {
+            if (!loadTrace(config.loadReference, suite, session, reference)) {
+                std::fprintf(stderr, "sympathetic-equiv: %s: no %s reference for this seed, length and block\n",
+                             config.loadReference.c_str(), suite.engine.c_str());
+                return 1;
+            }
+        } else {
+            suite.runReference(session, events, reference);
+        }
+        if (!config.saveReference.empty() && !saveTrace(config.saveReference, suite, session, reference)) {
+            std::fprintf(stderr, "sympathetic-equiv: cannot write %s\n", config.saveReference.c_str());
+            return 1;
+        }
+
+        Tolerance tolerance = config.tolerance;
+        if (tolerance.db < 0.0) tolerance.db = suite.db;
+        std::printf("%s: %.1f s, block %d, seed %u, %zu events, tolerance %lld ulp / %.0f dB\n",
+                    suite.engine.c_str(), session.seconds, session.block, session.seed, events.size(),
+                    static_cast<long long>(tolerance.ulp), tolerance.db);
+        std::printf("  reference: %s\n",
+                    config.loadReference.empty() ? suite.reference.c_str() : config.loadReference.c_str());
+
+        for (const EquivVariant& variant : suite.variants) {
+            if (variant.name.find(config.variant) == std::string::npos) continue;
+
+            Trace trace;
+            variant.run(session, events, trace);
+            Comparison c = compareTraces(suite, session, reference, trace, tolerance);
+            report(variant, c, events);
+            diverged |= c.first.found;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::fflush(stdout);
+        std::fprintf(stderr, "%s checked in %.1f s\n", suite.engine.c_str(), seconds);
+    }
+    return diverged ? 2 : 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * Equiv - suites of sympathetic-equiv
+ *
+ * A suite pairs an engine's scalar reference with its optimized variants.
+ * Both sides play the same scripted session: the suite turns a seed into a
+ * list of plucks and parameter changes, the reference applies them between
+ * samples and the variants schedule them into their blocks. Each run fills
+ * a Trace, which the harness (equiv.cpp) compares sample by sample.
+ *
+ * physics.h and sympathy.h cannot share a translation unit, so each engine
+ * has its suite in its own file (equiv_strings.cpp, equiv_mini.cpp).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct EquivSession {
+    uint32_t seed = 1;
+    double seconds = 30.0;
+    int block = 64;
+
+    int64_t frames() const { return static_cast<int64_t>(seconds * 44100.0); }
+    int64_t blocks() const { return (frames() + block - 1) / block; }
+};
+
+// One scripted change; type, index, a and b mean what the suite says
+struct EquivEvent {
+    int64_t frame;
+    int type;
+    int index;
+    float a;
+    float b;
+    std::string text;  // For divergence reports
+};
+
+// Seeded generator for scripts (same sequence on every platform)
+class EquivRandom {
+public:
+    explicit EquivRandom(uint32_t seed) : state(seed * 2654435761u + 1u) {}
+
+    float uniform(float lo, float hi) {
+        state = state * 1664525u + 1013904223u;
+        return lo + (hi - lo) * static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+    }
+    int below(int n) { return std::min(n - 1, static_cast<int>(uniform(0.0f, static_cast<float>(n)))); }
+
+private:
+    uint32_t state;
+};
+
+// A value recorded at the end of every block
+struct BlockQuantity {
+    const char* name;
+    bool relative;  // dB under the reference's peak of it, not full scale (energies)
+};
+
+struct Trace {
+    std::vector<float> left, right;  // Every frame
+    std::vector<float> perBlock;     // quantities.size() values per block
+};
+
+using EquivRunner = std::function<void(const EquivSession&, const std::vector<EquivEvent>&, Trace&)>;
+
+struct EquivVariant {
+    std::string name;
+    EquivRunner run;
+};
+
+struct EquivSuite {
+    std::string engine;
+    std::string reference;  // What the reference is, for the report
+    std::vector<BlockQuantity> quantities;
+    std::function<std::vector<EquivEvent>(const EquivSession&)> script;
+    EquivRunner runReference;
+    std::vector<EquivVariant> variants;  // Every kernel table this CPU runs
+    double db = 100.0;  // Default --db, room for the tails sleep drops (see the suites)
+};
+
+EquivSuite stringsSuite();
+EquivSuite miniSuite();
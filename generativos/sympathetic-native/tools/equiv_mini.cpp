@@ -0,0 +1,197 @@
+/**
+ * SympathyMini suite for sympathetic-equiv (see equiv.h)
+ *
+ * Reference: the synth's original per-sample loop, frozen here. Every
+ * sample computes the gated coupling, smooths the excitation and runs each
+ * string's String::process, with no vector kernels. The SympathyMini
+ * instance only holds the strings and parameters; its renderBlock is never
+ * called.
+ *
+ * Variants: renderBlock (delay-length chunks, sleep, scheduled events) with
+ * each kernel table this CPU runs.
+ *
+ * Compared: left / right output every frame; each string's level (its
+ * peak follower) at the end of every block. There is no bridge.
+ *
+ * The reference never sleeps. The variants drop each tail under
+ * SLEEP_LEVEL (-100 dB) that the reference keeps ringing, and the coupling
+ * carries the difference into the other strings; where the coupling loop
+ * gains more than it decays, the difference grows with the signal. 30 s
+ * sessions stay under -63 dB, hence a default --db of 60.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "equiv.h"
+#include "sympathy.h"
+
+static const BlockQuantity QUANTITIES[] = {
+    {"levelC", false},
+    {"levelE", false},
+    {"levelG", false},
+    {"levelB", false},
+};
+
+// 0.1 .. 1 s, and one gap in eight six times longer
+static float nextGap(EquivRandom& rng) {
+    float gap = rng.uniform(0.1f, 1.0f);
+    return rng.below(8) == 0 ? 6.0f * gap : gap;
+}
+
+// A pluck every 0.1 .. 1 s and now and then a parameter change, with
+// gaps long enough for strings to fall asleep and be woken again
+static std::vector<EquivEvent> miniScript(const EquivSession& session) {
+    using Synth = SympathyMini;
+    EquivRandom rng(session.seed);
+    std::vector<EquivEvent> events;
+
+    char text[64];
+    for (double t = 0.0; t < session.seconds; t += nextGap(rng)) {
+        EquivEvent e = {static_cast<int64_t>(t * SAMPLE_RATE), 0, 0, 0.0f, 0.0f, ""};
+        float kind = rng.uniform(0.0f, 1.0f);
+        if (kind < 0.7f) {
+            e.type = Synth::PLUCK_EVENT;
+            e.index = rng.below(NUM_STRINGS);
+            e.a = rng.uniform(0.2f, 1.0f);
+            std::snprintf(text, sizeof(text), "pluck %d %.2f", e.index, e.a);
+        } else if (kind < 0.8f) {
+            e.type = Synth::SYMPATHY_EVENT;
+            e.a = rng.uniform(0.0f, 1.0f);
+            std::snprintf(text, sizeof(text), "sympathy %.2f", e.a);
+        } else if (kind < 0.87f) {
+            e.type = Synth::COUPLING_EVENT;
+            e.a = rng.uniform(0.001f, 0.2f);
+            std::snprintf(text, sizeof(text), "coupling %.3f", e.a);
+        } else if (kind < 0.94f) {
+            e.type = Synth::DECAY_EVENT;
+            e.a = rng.uniform(0.5f, 0.999f);
+            std::snprintf(text, sizeof(text), "decay %.3f", e.a);
+        } else {
+            e.type = Synth::GATE_EVENT;
+            e.a = rng.uniform(0.0f, 0.05f);
+            std::snprintf(text, sizeof(text), "gate %.3f", e.a);
+        }
+        e.text = text;
+        events.push_back(e);
+    }
+    return events;
+}
+
+static void applyEvent(SympathyMini& synth, const EquivEvent& e) {
+    switch (e.type) {
+        case SympathyMini::PLUCK_EVENT: synth.pluck(e.index, e.a); break;
+        case SympathyMini::SYMPATHY_EVENT: synth.setSympatheticAmount(e.a); break;
+        case SympathyMini::VOLUME_EVENT: synth.setMasterVolume(e.a); break;
+        case SympathyMini::GATE_EVENT: synth.setGateThreshold(e.a); break;
+        case SympathyMini::DECAY_EVENT: synth.setExcitationDecay(e.a); break;
+        case SympathyMini::COUPLING_EVENT: synth.setCouplingScale(e.a); break;
+    }
+}
+
+static void recordBlock(const SympathyMini& synth, Trace& trace) {
+    for (int s = 0; s < NUM_STRINGS; s++) trace.perBlock.push_back(synth.strings[s].getEnergy());
+}
+
+// One sample of the per-sample synth
+static void referenceSample(SympathyMini& synth, float& outL, float& outR) {
+    float scale = synth.sympathyAmount * synth.couplingScale;
+    float blend = 1.0f - synth.excitationDecay;
+
+    float excitation[NUM_STRINGS] = {0};
+    for (int src = 0; src < NUM_STRINGS; src++) {
+        if (synth.strings[src].getEnergy() < synth.gateThreshold) continue;
+        for (int tgt = 0; tgt < NUM_STRINGS; tgt++) {
+            if (src != tgt) {
+                excitation[tgt] += synth.stringOutputs[src] * COUPLING[src][tgt] * scale;
+            }
+        }
+    }
+
+    float left = 0.0f, right = 0.0f;
+    for (int s = 0; s < NUM_STRINGS; s++) {
+        float& accum = synth.excitationAccum[s];
+        accum = accum * synth.excitationDecay + excitation[s] * blend;
+        accum = std::max(-0.1f, std::min(0.1f, accum));
+
+        synth.stringOutputs[s] = synth.strings[s].process(accum);
+
+        float pan = static_cast<float>(s) / (NUM_STRINGS - 1);
+        left += synth.stringOutputs[s] * (1.0f - pan);
+        right += synth.stringOutputs[s] * pan;
+    }
+
+    left *= synth.masterVolume;
+    right *= synth.masterVolume;
+
+    if (left > 0.95f) left = 0.95f + std::tanh(left - 0.95f) * 0.05f;
+    if (left < -0.95f) left = -0.95f + std::tanh(left + 0.95f) * 0.05f;
+    if (right > 0.95f) right = 0.95f + std::tanh(right - 0.95f) * 0.05f;
+    if (right < -0.95f) right = -0.95f + std::tanh(right + 0.95f) * 0.05f;
+
+    outL = left;
+    outR = right;
+}
+
+static void runReference(const EquivSession& session, const std::vector<EquivEvent>& events,
+                         Trace& trace) {
+    auto synth = std::make_unique<SympathyMini>();
+
+    DenormalGuard guard;  // renderBlock runs under it as well
+    const int64_t frames = session.frames();
+    size_t next = 0;
+    for (int64_t f = 0; f < frames; f++) {
+        for (; next < events.size() && events[next].frame == f; next++) applyEvent(*synth, events[next]);
+
+        float left, right;
+        referenceSample(*synth, left, right);
+        trace.left.push_back(left);
+        trace.right.push_back(right);
+
+        if ((f + 1) % session.block == 0 || f + 1 == frames) recordBlock(*synth, trace);
+    }
+}
+
+static EquivRunner blockRunner(const KarplusKernels* kernels) {
+    return [kernels](const EquivSession& session, const std::vector<EquivEvent>& events, Trace& trace) {
+        auto synth = std::make_unique<SympathyMini>();
+        synth->kernels = kernels;
+
+        const int64_t frames = session.frames();
+        std::vector<float> left(session.block), right(session.block);
+        size_t next = 0;
+        for (int64_t pos = 0; pos < frames; pos += session.block) {
+            int n = static_cast<int>(std::min<int64_t>(session.block, frames - pos));
+            for (; next < events.size() && events[next].frame < pos + n; next++) {
+                const EquivEvent& e = events[next];
+                synth->events.push({static_cast<int>(e.frame - pos), e.type, e.index, e.a, e.b});
+            }
+
+            synth->renderBlock(n, left.data(), right.data());
+            trace.left.insert(trace.left.end(), left.begin(), left.begin() + n);
+            trace.right.insert(trace.right.end(), right.begin(), right.begin() + n);
+            recordBlock(*synth, trace);
+        }
+    };
+}
+
+EquivSuite miniSuite() {
+    EquivSuite suite;
+    suite.engine = "mini";
+    suite.reference = "per-sample String::process loop";
+    suite.quantities.assign(std::begin(QUANTITIES), std::end(QUANTITIES));
+    suite.script = miniScript;
+    suite.runReference = runReference;
+    suite.db = 60.0;
+    for (const char* name : {"scalar", "avx2", "avx512"}) {
+        if (const KarplusKernels* kernels = findKarplusKernels(name)) {
+            suite.variants.push_back({std::string("renderBlock/") + name, blockRunner(kernels)});
+        }
+    }
+    return suite;
+}
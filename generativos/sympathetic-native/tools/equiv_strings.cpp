@@ -0,0 +1,254 @@
+/**
+ * SympatheticStrings suite for sympathetic-equiv (see equiv.h)
+ *
+ * Reference: the engine's explicit multi-rate step loop, frozen here with
+ * the scalar stencil written out inline. Every base step runs the substep
+ * begin, bridge solve and commit of stepExplicit, with no kernel table,
+ * no fused substeps and no sleep, and every sample reads the pickups. The
+ * SympatheticStrings instance only holds the strings and parameters and
+ * takes the script through its setters; its step functions are never
+ * called.
+ *
+ * Variants: renderBlock (fused substeps, sleep, scheduled events) with each
+ * kernel table this CPU runs.
+ *
+ * Compared: left / right output every frame; bridge displacement and both
+ * string energies at the end of every block. renderBlock does not expose the
+ * bridge per sample, hence once a block. The energies are sums that the
+ * vector kernels reduce in another order, so they differ in the last few
+ * bits even where the displacements are identical.
+ *
+ * The reference never sleeps. The variants drop each tail under
+ * SLEEP_ENERGY (about -100 dB), and what the reference keeps of those tails
+ * adds up over a session; 30 s sessions stay under -85 dB, hence a default
+ * --db of 80.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "equiv.h"
+#include "physics.h"
+
+constexpr float EQUIV_PICKUP = 0.3f;
+
+static const BlockQuantity QUANTITIES[] = {
+    {"bridge", false},
+    {"energy1", true},
+    {"energy2", true},
+};
+
+// Something every 0.25 .. 1.5 s: mostly plucks, sometimes a retune,
+// damping or stiffness change
+static std::vector<EquivEvent> stringsScript(const EquivSession& session) {
+    using Sim = SympatheticStrings;
+    EquivRandom rng(session.seed);
+    std::vector<EquivEvent> events;
+    events.push_back({0, Sim::PLUCK_EVENT, 0, 0.3f, 0.5f, "pluck 0 0.30 0.50"});
+
+    char text[64];
+    for (double t = rng.uniform(0.25f, 1.5f); t < session.seconds; t += rng.uniform(0.25f, 1.5f)) {
+        EquivEvent e = {static_cast<int64_t>(t * SAMPLE_RATE), 0, 0, 0.0f, 0.0f, ""};
+        float kind = rng.uniform(0.0f, 1.0f);
+        if (kind < 0.6f) {
+            e.type = Sim::PLUCK_EVENT;
+            e.index = rng.below(2);
+            e.a = rng.uniform(0.1f, 0.9f);
+            e.b = rng.uniform(0.1f, 0.8f);
+            std::snprintf(text, sizeof(text), "pluck %d %.2f %.2f", e.index, e.a, e.b);
+        } else if (kind < 0.75f) {
+            e.type = Sim::FREQUENCY_EVENT;
+            e.index = rng.below(2);
+            e.a = rng.uniform(80.0f, 900.0f);
+            std::snprintf(text, sizeof(text), "freq%d %.2f", e.index + 1, e.a);
+        } else if (kind < 0.85f) {
+            e.type = Sim::DAMPING_EVENT;
+            e.a = rng.uniform(1e-6f, 1e-4f);
+            std::snprintf(text, sizeof(text), "damping %.3g", e.a);
+        } else {
+            e.type = Sim::STIFFNESS_EVENT;
+            e.a = rng.uniform(0.2f, 1.0f);
+            std::snprintf(text, sizeof(text), "stiffness %.2f", e.a);
+        }
+        e.text = text;
+        events.push_back(e);
+    }
+    return events;
+}
+
+static void recordBlock(SympatheticStrings& sim, Trace& trace) {
+    trace.perBlock.push_back(sim.getBridgeY());
+    trace.perBlock.push_back(sim.getEnergy1());
+    trace.perBlock.push_back(sim.getEnergy2());
+}
+
+// ============================================================================
+// Frozen Step Loop
+// ============================================================================
+// stepExplicit and the scalar stencil kernels as they are; a rewrite of
+// the engine is compared against this copy, so it does not follow one.
+static float referenceCourantSq(const StringState& s, float dt, int stride) {
+    float r = s.waveSpeed * (dt * stride) / s.dx();
+    return r * r;
+}
+
+static void referenceBegin(StringState& s, float dt, int64_t step) {
+    if (step % s.stride != 0) return;
+
+    const int N = s.numPoints;
+    float rSq = referenceCourantSq(s, dt, s.stride);
+    float damping = s.damping * s.stride;
+    float stepDt = dt * s.stride;
+    s.y_next[0] = 0.0f;
+    for (int i = 1; i < N - 1; i++) {
+        float lap = s.y[i+1] - 2.0f * s.y[i] + s.y[i-1];
+        float vel = (s.y[i] - s.y_prev[i]) / stepDt;
+        s.y_next[i] = 2.0f * s.y[i] - s.y_prev[i] + rSq * lap - damping * stepDt * vel;
+    }
+    s.inFlight = true;
+}
+
+static float referenceNeighbor(const StringState& s, int64_t step) {
+    const int N = s.numPoints;
+    if (!s.inFlight) return s.y[N-2];
+
+    int k = static_cast<int>(step % s.stride);
+    return s.y[N-2] + (s.y_next[N-2] - s.y[N-2]) * k / s.stride;
+}
+
+static float referenceWant(const SympatheticStrings& sim, const StringState& s, float neighbor,
+                           int stride) {
+    float stepDt = sim.dt * stride;
+    return 2.0f * sim.bridgeY - sim.bridgePrevY
+         + referenceCourantSq(s, sim.dt, stride) * (neighbor - 2.0f * sim.bridgeY + sim.bridgeY)
+         - s.damping * stride * stepDt * (sim.bridgeY - sim.bridgePrevY) / stepDt;
+}
+
+static void referenceBridge(SympatheticStrings& sim, float y1_want, float y2_want, int stride) {
+    float totalTension = sim.string1.tension + sim.string2.tension;
+    float newBridgeY = (sim.string1.tension * y1_want + sim.string2.tension * y2_want) / totalTension;
+
+    float stiffness = sim.bridgeStiffness;
+    if (stride > 1) stiffness = 1.0f - std::pow(1.0f - sim.bridgeStiffness, static_cast<float>(stride));
+    newBridgeY = stiffness * newBridgeY + (1.0f - stiffness) * sim.bridgeY;
+
+    newBridgeY = std::max(-0.5f, std::min(0.5f, newBridgeY));
+    if (!std::isfinite(newBridgeY)) newBridgeY = 0.0f;
+
+    sim.bridgeV = (newBridgeY - sim.bridgeY) / (sim.dt * stride);
+    sim.bridgePrevY = sim.bridgeY;
+    sim.bridgeY = newBridgeY;
+}
+
+static void referenceEnd(StringState& s, float bridgeY, float dt, int64_t step) {
+    if (!s.inFlight || (step + 1) % s.stride != 0) return;
+
+    const int N = s.numPoints;
+    float stepDt = dt * s.stride;
+    s.y_next[N-1] = bridgeY;
+    for (int i = 0; i < N; i++) {
+        s.v[i] = (s.y_next[i] - s.y[i]) / stepDt;
+        s.y_prev[i] = s.y[i];
+        s.y[i] = s.y_next[i];
+    }
+    s.inFlight = false;
+}
+
+// Base step `step` of both strings and the bridge
+static void referenceStep(SympatheticStrings& sim, int64_t step) {
+    referenceBegin(sim.string1, sim.dt, step);
+    referenceBegin(sim.string2, sim.dt, step);
+
+    int stride = std::min(sim.string1.stride, sim.string2.stride);
+    if ((step + 1) % stride == 0) {
+        int64_t start = step + 1 - stride;
+        referenceBridge(sim, referenceWant(sim, sim.string1, referenceNeighbor(sim.string1, start), stride),
+                        referenceWant(sim, sim.string2, referenceNeighbor(sim.string2, start), stride), stride);
+    }
+
+    referenceEnd(sim.string1, sim.bridgeY, sim.dt, step);
+    referenceEnd(sim.string2, sim.bridgeY, sim.dt, step);
+    sim.markEnergyDirty();
+}
+
+static float referencePickup(const StringState& s) {
+    return s.y[std::min(s.numPoints - 1, static_cast<int>(EQUIV_PICKUP * s.numPoints))] * PICKUP_GAIN;
+}
+
+static void runReference(const EquivSession& session, const std::vector<EquivEvent>& events,
+                         Trace& trace) {
+    auto sim = std::make_unique<SympatheticStrings>();
+    sim->kernels = findStencilKernels("scalar");  // Energies only
+
+    DenormalGuard guard;  // renderBlock runs under it as well
+    const int64_t frames = session.frames();
+    int64_t step = 0;
+    size_t next = 0;
+    for (int64_t f = 0; f < frames; f++) {
+        for (; next < events.size() && events[next].frame == f; next++) {
+            const EquivEvent& e = events[next];
+            switch (e.type) {
+                case SympatheticStrings::PLUCK_EVENT: sim->pluck(e.index, e.a, e.b); break;
+                case SympatheticStrings::FREQUENCY_EVENT:
+                    if (e.index == 0) sim->setString1Frequency(e.a);
+                    else sim->setString2Frequency(e.a);
+                    break;
+                case SympatheticStrings::DAMPING_EVENT: sim->setDamping(e.a); break;
+                case SympatheticStrings::STIFFNESS_EVENT: sim->setBridgeStiffness(e.a); break;
+            }
+        }
+
+        for (int k = 0; k < OVERSAMPLING; k++) referenceStep(*sim, step++);
+
+        float s1 = referencePickup(sim->string1);
+        float s2 = referencePickup(sim->string2);
+        trace.left.push_back(s1 * STEREO_MIX + s2 * (1.0f - STEREO_MIX));
+        trace.right.push_back(s1 * (1.0f - STEREO_MIX) + s2 * STEREO_MIX);
+
+        if ((f + 1) % session.block == 0 || f + 1 == frames) recordBlock(*sim, trace);
+    }
+}
+
+static EquivRunner blockRunner(const StencilKernels* kernels) {
+    return [kernels](const EquivSession& session, const std::vector<EquivEvent>& events, Trace& trace) {
+        auto sim = std::make_unique<SympatheticStrings>();
+        sim->kernels = kernels;
+
+        const int64_t frames = session.frames();
+        std::vector<float> left(session.block), right(session.block);
+        size_t next = 0;
+        for (int64_t pos = 0; pos < frames; pos += session.block) {
+            int n = static_cast<int>(std::min<int64_t>(session.block, frames - pos));
+            for (; next < events.size() && events[next].frame < pos + n; next++) {
+                const EquivEvent& e = events[next];
+                sim->events.push({static_cast<int>(e.frame - pos), e.type, e.index, e.a, e.b});
+            }
+
+            sim->renderBlock(n, EQUIV_PICKUP, left.data(), right.data());
+            trace.left.insert(trace.left.end(), left.begin(), left.begin() + n);
+            trace.right.insert(trace.right.end(), right.begin(), right.begin() + n);
+            recordBlock(*sim, trace);
+        }
+    };
+}
+
+EquivSuite stringsSuite() {
+    EquivSuite suite;
+    suite.engine = "strings";
+    suite.reference = "frozen explicit step loop, one base step at a time";
+    suite.quantities.assign(std::begin(QUANTITIES), std::end(QUANTITIES));
+    suite.script = stringsScript;
+    suite.runReference = runReference;
+    suite.db = 80.0;
+    for (const char* name : {"scalar", "simd128", "avx2", "avx512"}) {
+        if (const StencilKernels* kernels = findStencilKernels(name)) {
+            suite.variants.push_back({std::string("renderBlock/") + name, blockRunner(kernels)});
+        }
+    }
+    return suite;
+}
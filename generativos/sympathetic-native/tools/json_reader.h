@@ -0,0 +1,161 @@
+/**
+ * JSON Reader - the little JSON the native tools read
+ *
+ * Objects, arrays, numbers, strings (simple escapes) and literals, parsed
+ * into a Json tree. Each value keeps its source line for error messages.
+ * Used for render scores (render.cpp) and benchmark baselines (bench.cpp).
+ */
+
+#pragma once
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct Json {
+    enum Type { Null, Bool, Number, String, Array, Object } type = Null;
+    double number = 0.0;
+    std::string text;
+    std::vector<Json> items;
+    std::vector<std::pair<std::string, Json>> members;
+    int line = 0;
+
+    const Json* get(const char* key) const {
+        for (const auto& m : members) {
+            if (m.first == key) return &m.second;
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : s(text) {}
+
+    bool parse(Json& out) {
+        if (!value(out)) return false;
+        skip();
+        return pos == s.size() || error("trailing characters");
+    }
+
+    const std::string& message() const { return err; }
+    int errorLine() const { return line; }
+
+private:
+    const std::string& s;
+    size_t pos = 0;
+    int line = 1;
+    std::string err;
+
+    bool error(const char* what) {
+        if (err.empty()) err = what;
+        return false;
+    }
+
+    void skip() {
+        while (pos < s.size() && std::isspace(static_cast<unsigned char>(s[pos]))) {
+            if (s[pos] == '\n') line++;
+            pos++;
+        }
+    }
+
+    bool literal(const char* word) {
+        size_t n = std::strlen(word);
+        if (s.compare(pos, n, word) != 0) return error("unexpected token");
+        pos += n;
+        return true;
+    }
+
+    bool string(std::string& out) {
+        pos++;  // Opening quote
+        while (pos < s.size() && s[pos] != '"') {
+            char c = s[pos++];
+            if (c == '\\' && pos < s.size()) {
+                c = s[pos++];
+                if (c == 'n') c = '\n';
+                else if (c == 't') c = '\t';
+                else if (c != '"' && c != '\\' && c != '/') return error("unsupported escape");
+            }
+            out += c;
+        }
+        if (pos == s.size()) return error("unterminated string");
+        pos++;
+        return true;
+    }
+
+    bool value(Json& out) {
+        skip();
+        out.line = line;
+        if (pos == s.size()) return error("unexpected end");
+
+        char c = s[pos];
+        if (c == '{') {
+            out.type = Json::Object;
+            pos++;
+            skip();
+            if (pos < s.size() && s[pos] == '}') { pos++; return true; }
+            for (;;) {
+                skip();
+                std::string key;
+                if (pos == s.size() || s[pos] != '"' || !string(key)) return error("expected key");
+                skip();
+                if (pos == s.size() || s[pos++] != ':') return error("expected ':'");
+                out.members.emplace_back(key, Json());
+                if (!value(out.members.back().second)) return false;
+                skip();
+                if (pos < s.size() && s[pos] == ',') { pos++; continue; }
+                if (pos < s.size() && s[pos] == '}') { pos++; return true; }
+                return error("expected ',' or '}'");
+            }
+        }
+        if (c == '[') {
+            out.type = Json::Array;
+            pos++;
+            skip();
+            if (pos < s.size() && s[pos] == ']') { pos++; return true; }
+            for (;;) {
+                out.items.emplace_back();
+                if (!value(out.items.back())) return false;
+                skip();
+                if (pos < s.size() && s[pos] == ',') { pos++; continue; }
+                if (pos < s.size() && s[pos] == ']') { pos++; return true; }
+                return error("expected ',' or ']'");
+            }
+        }
+        if (c == '"') {
+            out.type = Json::String;
+            return string(out.text);
+        }
+        if (c == 't' || c == 'f') {
+            out.type = Json::Bool;
+            out.number = c == 't';
+            return literal(c == 't' ? "true" : "false");
+        }
+        if (c == 'n') return literal("null");
+
+        char* end;
+        out.type = Json::Number;
+        out.number = std::strtod(s.c_str() + pos, &end);
+        if (end == s.c_str() + pos) return error("unexpected character");
+        // strtod also takes inf, nan and overflows to inf; JSON has none of them
+        if (!std::isfinite(out.number)) return error("number out of range");
+        pos = end - s.c_str();
+        return true;
+    }
+};
+
+// Whole file into text; false if it cannot be read
+inline bool readFile(const std::string& path, std::string& text) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    text = buffer.str();
+    return true;
+}
@@ -0,0 +1,349 @@
+/**
+ * Sympathetic Render - offline WAV rendering of a score
+ *
+ * Plays a score of plucks and parameter changes through SympatheticStrings
+ * or SympathyMini as fast as the engine runs, and streams the result to a
+ * stereo WAV file (32-bit float or 24-bit PCM, see wav_writer.h).
+ *
+ *   sympathetic-render score.txt --out take.wav --format pcm24
+ *
+ * Text scores hold one event per line, "time command args...", with time in
+ * seconds, plus the directives "engine strings|mini" and "duration S":
+ *
+ *   engine strings
+ *   0.0   pluck 0 0.3 0.5      # string, position, amplitude
+ *   2.5   damping 2e-5
+ *   3.0   freq2 331
+ *
+ * JSON scores carry the same information:
+ *
+ *   {"engine": "mini", "duration": 10,
+ *    "events": [{"time": 0, "type": "pluck", "string": 2, "velocity": 0.8}]}
+ *
+ * Commands and their arguments per engine (JSON keys in the same order):
+ *   strings: pluck string position amplitude, freq1, freq2, damping,
+ *            stiffness (one "value" each)
+ *   mini:    pluck string velocity, sympathy, volume, gate, decay,
+ *            coupling (one "value" each)
+ *
+ * Events go through the engines' event queues, so they land on their exact
+ * sample however large the render block is. Without a duration the render
+ * runs until TAIL_SECONDS after the last event.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "json_reader.h"
+#include "render_engine.h"
+#include "wav_writer.h"
+
+constexpr int RENDER_BLOCK = 4096;    // Frames per renderBlock call
+constexpr double TAIL_SECONDS = 4.0;  // Ring-out after the last event
+
+// An event as read from the score, before the engine resolves its arguments
+struct ParsedEvent {
+    ScoreEvent event;
+    std::vector<std::pair<std::string, double>> named;  // JSON arguments by key
+    bool byName = false;
+};
+
+struct Score {
+    std::string engine;
+    double duration = -1.0;
+    std::vector<ParsedEvent> events;
+};
+
+static bool fail(const std::string& where, const std::string& message) {
+    std::fprintf(stderr, "sympathetic-render: %s: %s\n", where.c_str(), message.c_str());
+    return false;
+}
+
+// ============================================================================
+// Text scores
+// ============================================================================
+static bool parseNumber(const std::string& text, double& value) {
+    char* end;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0' && std::isfinite(value);
+}
+
+static bool parseTextScore(const std::string& text, const std::string& path, Score& score) {
+    std::istringstream lines(text);
+    std::string line;
+    for (int lineNo = 1; std::getline(lines, line); lineNo++) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream in(line);
+        std::vector<std::string> tokens;
+        for (std::string t; in >> t;) tokens.push_back(t);
+        if (tokens.empty()) continue;
+
+        const std::string where = path + ":" + std::to_string(lineNo);
+        if (tokens[0] == "engine" && tokens.size() == 2) {
+            score.engine = tokens[1];
+            continue;
+        }
+        if (tokens[0] == "duration" && tokens.size() == 2) {
+            if (!parseNumber(tokens[1], score.duration)) return fail(where, "bad duration");
+            continue;
+        }
+
+        ParsedEvent parsed;
+        parsed.event.line = lineNo;
+        if (tokens.size() < 2 || !parseNumber(tokens[0], parsed.event.time)) {
+            return fail(where, "expected \"time command args...\"");
+        }
+        parsed.event.command = tokens[1];
+        for (size_t i = 2; i < tokens.size(); i++) {
+            double v;
+            if (!parseNumber(tokens[i], v)) return fail(where, "bad argument \"" + tokens[i] + "\"");
+            parsed.event.args.push_back(static_cast<float>(v));
+        }
+        score.events.push_back(std::move(parsed));
+    }
+    return true;
+}
+
+// ============================================================================
+// JSON scores
+// ============================================================================
+static bool parseJsonScore(const std::string& text, const std::string& path, Score& score) {
+    Json root;
+    JsonParser parser(text);
+    if (!parser.parse(root)) {
+        return fail(path + ":" + std::to_string(parser.errorLine()), parser.message());
+    }
+    if (root.type != Json::Object) return fail(path, "expected an object");
+
+    if (const Json* engine = root.get("engine")) score.engine = engine->text;
+    if (const Json* duration = root.get("duration")) {
+        if (duration->type != Json::Number) return fail(path, "\"duration\" must be a number");
+        score.duration = duration->number;
+    }
+
+    const Json* events = root.get("events");
+    if (!events || events->type != Json::Array) return fail(path, "missing \"events\" array");
+
+    for (const Json& e : events->items) {
+        const std::string where = path + ":" + std::to_string(e.line);
+        const Json* time = e.get("time");
+        const Json* type = e.get("type");
+        if (e.type != Json::Object || !time || time->type != Json::Number
+            || !type || type->type != Json::String) {
+            return fail(where, "event needs a numeric \"time\" and a \"type\"");
+        }
+
+        ParsedEvent parsed;
+        parsed.event.time = time->number;
+        parsed.event.command = type->text;
+        parsed.event.line = e.line;
+        parsed.byName = true;
+        for (const auto& m : e.members) {
+            if (m.second.type == Json::Number || m.second.type == Json::Bool) {
+                parsed.named.emplace_back(m.first, m.second.number);
+            }
+        }
+        score.events.push_back(std::move(parsed));
+    }
+    return true;
+}
+
+// ============================================================================
+// Score loading
+// ============================================================================
+static bool loadScore(const std::string& path, Score& score) {
+    std::string text;
+    if (!readFile(path, text)) return fail(path, "cannot read");
+
+    size_t first = text.find_first_not_of(" \t\r\n");
+    bool json = first != std::string::npos && text[first] == '{';
+    return json ? parseJsonScore(text, path, score) : parseTextScore(text, path, score);
+}
+
+// Checks every event against the engine's commands and fills its arguments
+static bool resolveEvents(const RenderEngine& engine, const std::string& path,
+                          std::vector<ParsedEvent>& parsed, std::vector<ScoreEvent>& events) {
+    for (ParsedEvent& p : parsed) {
+        ScoreEvent& e = p.event;
+        const std::string where = path + ":" + std::to_string(e.line);
+        const auto& specs = engine.commands();
+        auto spec = std::find_if(specs.begin(), specs.end(),
+                                 [&](const CommandSpec& s) { return e.command == s.name; });
+        if (spec == specs.end()) {
+            return fail(where, "unknown " + std::string(engine.name()) + " command \"" + e.command + "\"");
+        }
+        if (e.time < 0.0) return fail(where, "negative time");
+
+        if (p.byName) {
+            for (const char* key : spec->args) {
+                auto arg = std::find_if(p.named.begin(), p.named.end(),
+                                        [&](const std::pair<std::string, double>& n) { return n.first == key; });
+                if (arg == p.named.end()) return fail(where, e.command + " needs \"" + key + "\"");
+                e.args.push_back(static_cast<float>(arg->second));
+            }
+        } else if (e.args.size() != spec->args.size()) {
+            std::string expected;
+            for (const char* a : spec->args) expected += std::string(" ") + a;
+            return fail(where, "usage: time " + e.command + expected);
+        }
+        events.push_back(std::move(e));
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const ScoreEvent& a, const ScoreEvent& b) { return a.time < b.time; });
+    return true;
+}
+
+// ============================================================================
+// Command line
+// ============================================================================
+struct RenderConfig {
+    std::string score;
+    std::string out = "render.wav";
+    std::string engine;          // Overrides the score's
+    WavFormat format = WavFormat::Float32;
+    double seconds = -1.0;       // Overrides the score's duration
+    RenderOptions options;
+};
+
+static void usage() {
+    std::fprintf(stderr,
+        "usage: sympathetic-render SCORE [options]\n"
+        "  --out FILE          output WAV (default render.wav)\n"
+        "  --format F          float (32-bit, default) or pcm24\n"
+        "  --engine E          strings or mini (default: the score's, else strings)\n"
+        "  --seconds S         length (default: the score's duration, else the\n"
+        "                      last event plus %.0f s)\n"
+        "  --pickup POS        strings pickup position (default 0.3)\n"
+        "  --implicit          strings implicit θ-scheme\n", TAIL_SECONDS);
+}
+
+static bool parseArgs(int argc, char** argv, RenderConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--implicit") {
+            config.options.implicit = true;
+            continue;
+        }
+        if (arg.compare(0, 2, "--") != 0) {
+            if (!config.score.empty()) return false;
+            config.score = arg;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+
+        if (arg == "--out") config.out = value;
+        else if (arg == "--engine") config.engine = value;
+        else if (arg == "--seconds") {
+            if (!parseNumber(value, config.seconds)) return false;
+        }
+        else if (arg == "--pickup") config.options.pickup = std::strtof(value.c_str(), nullptr);
+        else if (arg == "--format" && value == "float") config.format = WavFormat::Float32;
+        else if (arg == "--format" && value == "pcm24") config.format = WavFormat::Pcm24;
+        else return false;
+    }
+    return !config.score.empty();
+}
+
+int main(int argc, char** argv) {
+    RenderConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        usage();
+        return 1;
+    }
+
+    Score score;
+    if (!loadScore(config.score, score)) return 1;
+
+    std::string engineName = !config.engine.empty() ? config.engine
+                           : !score.engine.empty() ? score.engine : "strings";
+    std::unique_ptr<RenderEngine> engine;
+    if (engineName == "strings") engine = makeStringsRenderEngine(config.options);
+    else if (engineName == "mini") engine = makeMiniRenderEngine(config.options);
+    else {
+        fail(config.score, "unknown engine \"" + engineName + "\"");
+        return 1;
+    }
+
+    std::vector<ScoreEvent> events;
+    if (!resolveEvents(*engine, config.score, score.events, events)) return 1;
+
+    double seconds = config.seconds > 0.0 ? config.seconds
+                   : score.duration > 0.0 ? score.duration
+                   : (events.empty() ? 0.0 : events.back().time) + TAIL_SECONDS;
+    // Checked before rendering, not discovered by close() hours later
+    if (seconds * RENDER_RATE > static_cast<double>(WavWriter::maxFrames(config.format))) {
+        fail(config.out, "longer than a WAV file can hold (" +
+             std::to_string(WavWriter::maxFrames(config.format) / RENDER_RATE / 60) + " min in this format)");
+        return 1;
+    }
+    const int64_t totalFrames = static_cast<int64_t>(std::llround(seconds * RENDER_RATE));
+
+    WavWriter wav;
+    if (!wav.open(config.out, config.format, RENDER_RATE)) {
+        fail(config.out, "cannot write");
+        return 1;
+    }
+
+    std::vector<float> left(RENDER_BLOCK), right(RENDER_BLOCK);
+    float peak = 0.0f;
+    size_t next = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t pos = 0; pos < totalFrames;) {
+        int64_t end = std::min<int64_t>(pos + RENDER_BLOCK, totalFrames);
+
+        // Queue this block's events; a full queue ends the block early at
+        // the first event that did not fit
+        for (; next < events.size(); next++) {
+            double frame = events[next].time * RENDER_RATE;
+            if (frame >= static_cast<double>(end)) break;  // Before llround, which overflows on huge times
+            int64_t at = std::llround(frame);
+            if (at >= end) break;
+            if (!engine->schedule(static_cast<int>(at - pos), events[next])) {
+                end = at;
+                break;
+            }
+        }
+        if (end == pos) {
+            fail(config.score, "too many events on one sample");
+            return 1;
+        }
+
+        const int frames = static_cast<int>(end - pos);
+        engine->render(frames, left.data(), right.data());
+        for (int i = 0; i < frames; i++) {
+            peak = std::max(peak, std::max(std::fabs(left[i]), std::fabs(right[i])));
+        }
+        wav.write(left.data(), right.data(), frames);
+        pos = end;
+    }
+
+    if (!wav.close()) {
+        fail(config.out, "write failed");
+        return 1;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (next < events.size()) {
+        std::fprintf(stderr, "sympathetic-render: %zu events after the end were dropped\n",
+                     events.size() - next);
+    }
+    if (config.format == WavFormat::Pcm24 && peak > 1.0f) {
+        std::fprintf(stderr, "sympathetic-render: clipped (peak %.2f)\n", peak);
+    }
+    std::fprintf(stderr, "%.1f s of %s audio, %zu events, peak %.3f, in %.2f s (%.1fx realtime) -> %s\n",
+                 seconds, engine->name(), next, peak, wall,
+                 wall > 0.0 ? seconds / wall : 0.0, config.out.c_str());
+    return 0;
+}
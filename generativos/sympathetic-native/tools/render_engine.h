@@ -0,0 +1,52 @@
+/**
+ * Render Engine - what sympathetic-render needs from an engine
+ *
+ * physics.h and sympathy.h cannot share a translation unit (both define the
+ * engine constants), so each engine gets a small adapter in its own file
+ * (render_strings.cpp, render_mini.cpp) behind this interface. A score event
+ * is a command name plus numeric arguments; the adapter lists the commands
+ * it knows with their argument names (for JSON scores) and schedules each
+ * event at its sample through the engine's event queue.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+constexpr int RENDER_RATE = 44100;  // Both engines run at 44.1 kHz
+
+struct ScoreEvent {
+    double time = 0.0;       // Seconds
+    std::string command;
+    std::vector<float> args;
+    int line = 0;            // Source line, for error messages
+};
+
+struct CommandSpec {
+    const char* name;
+    std::vector<const char*> args;  // In order; also the JSON keys
+};
+
+struct RenderOptions {
+    float pickup = 0.3f;    // SympatheticStrings pickup position
+    bool implicit = false;  // SympatheticStrings θ-scheme
+};
+
+class RenderEngine {
+public:
+    virtual ~RenderEngine() = default;
+
+    virtual const char* name() const = 0;
+    virtual const std::vector<CommandSpec>& commands() const = 0;
+
+    // Queues an event `offset` samples into the next render(); false when
+    // the engine's queue is full
+    virtual bool schedule(int offset, const ScoreEvent& event) = 0;
+
+    virtual void render(int numFrames, float* outL, float* outR) = 0;
+};
+
+std::unique_ptr<RenderEngine> makeStringsRenderEngine(const RenderOptions& options);
+std::unique_ptr<RenderEngine> makeMiniRenderEngine(const RenderOptions& options);
@@ -0,0 +1,53 @@
+/**
+ * SympathyMini adapter for sympathetic-render (see render_engine.h)
+ */
+
+#include "render_engine.h"
+#include "sympathy.h"
+
+static_assert(SAMPLE_RATE == RENDER_RATE, "renderer assumes the engine rate");
+
+namespace {
+
+class MiniRenderEngine : public RenderEngine {
+public:
+    explicit MiniRenderEngine(const RenderOptions&) {}
+
+    const char* name() const override { return "mini"; }
+
+    const std::vector<CommandSpec>& commands() const override {
+        static const std::vector<CommandSpec> specs = {
+            {"pluck", {"string", "velocity"}},
+            {"sympathy", {"value"}},
+            {"volume", {"value"}},
+            {"gate", {"value"}},
+            {"decay", {"value"}},
+            {"coupling", {"value"}},
+        };
+        return specs;
+    }
+
+    bool schedule(int offset, const ScoreEvent& e) override {
+        const std::vector<float>& a = e.args;
+        if (e.command == "pluck") return synth.schedulePluck(offset, static_cast<int>(a[0]), a[1]);
+        if (e.command == "sympathy") return synth.scheduleSympatheticAmount(offset, a[0]);
+        if (e.command == "volume") return synth.scheduleMasterVolume(offset, a[0]);
+        if (e.command == "gate") return synth.scheduleGateThreshold(offset, a[0]);
+        if (e.command == "decay") return synth.scheduleExcitationDecay(offset, a[0]);
+        if (e.command == "coupling") return synth.scheduleCouplingScale(offset, a[0]);
+        return true;
+    }
+
+    void render(int numFrames, float* outL, float* outR) override {
+        synth.renderBlock(numFrames, outL, outR);
+    }
+
+private:
+    SympathyMini synth;
+};
+
+}  // namespace
+
+std::unique_ptr<RenderEngine> makeMiniRenderEngine(const RenderOptions& options) {
+    return std::make_unique<MiniRenderEngine>(options);
+}
@@ -0,0 +1,54 @@
+/**
+ * SympatheticStrings adapter for sympathetic-render (see render_engine.h)
+ */
+
+#include "render_engine.h"
+#include "physics.h"
+
+static_assert(SAMPLE_RATE == RENDER_RATE, "renderer assumes the engine rate");
+
+namespace {
+
+class StringsRenderEngine : public RenderEngine {
+public:
+    explicit StringsRenderEngine(const RenderOptions& options) : pickup(options.pickup) {
+        sim.setImplicit(options.implicit);
+    }
+
+    const char* name() const override { return "strings"; }
+
+    const std::vector<CommandSpec>& commands() const override {
+        static const std::vector<CommandSpec> specs = {
+            {"pluck", {"string", "position", "amplitude"}},
+            {"freq1", {"value"}},
+            {"freq2", {"value"}},
+            {"damping", {"value"}},
+            {"stiffness", {"value"}},
+        };
+        return specs;
+    }
+
+    bool schedule(int offset, const ScoreEvent& e) override {
+        const std::vector<float>& a = e.args;
+        if (e.command == "pluck") return sim.schedulePluck(offset, static_cast<int>(a[0]), a[1], a[2]);
+        if (e.command == "freq1") return sim.scheduleString1Frequency(offset, a[0]);
+        if (e.command == "freq2") return sim.scheduleString2Frequency(offset, a[0]);
+        if (e.command == "damping") return sim.scheduleDamping(offset, a[0]);
+        if (e.command == "stiffness") return sim.scheduleBridgeStiffness(offset, a[0]);
+        return true;
+    }
+
+    void render(int numFrames, float* outL, float* outR) override {
+        sim.renderBlock(numFrames, pickup, outL, outR);
+    }
+
+private:
+    SympatheticStrings sim;
+    float pickup;
+};
+
+}  // namespace
+
+std::unique_ptr<RenderEngine> makeStringsRenderEngine(const RenderOptions& options) {
+    return std::make_unique<StringsRenderEngine>(options);
+}
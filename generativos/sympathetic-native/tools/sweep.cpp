@@ -0,0 +1,297 @@
+/**
+ * Sympathetic Sweep - energy transfer over a parameter grid
+ *
+ * Runs one SympatheticStrings simulation per point of a grid over frequency
+ * ratio, bridge stiffness and damping: string 1 is plucked, string 2 starts
+ * at rest, and the run records how the energy flows between them. Points are
+ * independent and run on a work-stealing pool (work_stealing.h), one per
+ * task.
+ *
+ *   sympathetic-sweep --ratio 1:2:101 --stiffness 0.2:1:10 --damping 1e-5:1e-4:10
+ *
+ * Metrics per point (energies sampled every METRIC_SAMPLES audio samples):
+ *   - peakRatio:   maximum of E2 / E1
+ *   - peakTime:    time of that maximum (s)
+ *   - beatPeriod:  period of the energy exchange, from the crossings of
+ *                  E2 / (E1 + E2) through its mean (s, 0 if it never beats)
+ *   - e1, e2:      energies at the end of the run
+ *
+ * Ratios are only taken while the pair still holds at least ACTIVE_FRACTION
+ * of the plucked energy, so a decayed (or sleeping) pair cannot produce
+ * 0/0 noise.
+ *
+ * Output is CSV, or with a .bin file name a compact binary table:
+ *
+ *   "SSWP"  u32 version  u32 columns  u32 rows  u32 namesBytes
+ *   names   (namesBytes bytes, comma-separated column names)
+ *   rows    (rows * columns float32, row-major, little-endian)
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "physics.h"
+#include "work_stealing.h"
+
+constexpr int METRIC_SAMPLES = 32;        // Audio samples between energy readings
+constexpr float ACTIVE_FRACTION = 1e-3f;  // Share of the initial energy still "ringing"
+constexpr uint32_t SWEEP_VERSION = 1;
+
+static const char* COLUMNS[] = {
+    "ratio", "stiffness", "damping", "f1", "f2",
+    "peakRatio", "peakTime", "beatPeriod", "e1", "e2"
+};
+constexpr int NUM_COLUMNS = sizeof(COLUMNS) / sizeof(COLUMNS[0]);
+
+// ============================================================================
+// Parameter grid
+// ============================================================================
+// An axis "a:b:n" is n evenly spaced values from a to b ("a" alone is one)
+struct Axis {
+    double from = 0.0;
+    double to = 0.0;
+    int count = 1;
+
+    double at(int i) const {
+        return count == 1 ? from : from + (to - from) * i / (count - 1);
+    }
+};
+
+static bool parseAxis(const char* text, Axis& axis) {
+    char* end;
+    axis.from = std::strtod(text, &end);
+    if (end == text) return false;
+    axis.to = axis.from;
+    axis.count = 1;
+    if (*end == '\0') return true;
+
+    if (*end != ':') return false;
+    const char* next = end + 1;
+    axis.to = std::strtod(next, &end);
+    if (end == next || *end != ':') return false;
+    next = end + 1;
+    axis.count = static_cast<int>(std::strtol(next, &end, 10));
+    return end != next && *end == '\0' && axis.count >= 1;
+}
+
+struct SweepConfig {
+    Axis ratio{1.0, 2.0, 11};
+    Axis stiffness{1.0, 1.0, 1};
+    Axis damping{1e-5, 1e-5, 1};
+    float f1 = 220.0f;
+    float seconds = 2.0f;
+    float pluckPos = 0.3f;
+    bool implicit = false;
+    int threads = 0;
+    std::string out = "sweep.csv";
+
+    int points() const { return ratio.count * stiffness.count * damping.count; }
+};
+
+struct SweepPoint {
+    float ratio, stiffness, damping;
+};
+
+// Point i of the grid, damping fastest
+static SweepPoint pointAt(const SweepConfig& config, int i) {
+    int d = i % config.damping.count;
+    int s = (i / config.damping.count) % config.stiffness.count;
+    int r = i / (config.damping.count * config.stiffness.count);
+    return {static_cast<float>(config.ratio.at(r)), static_cast<float>(config.stiffness.at(s)),
+            static_cast<float>(config.damping.at(d))};
+}
+
+// ============================================================================
+// One run
+// ============================================================================
+// Mean spacing of the upward crossings of x through its mean, in readings.
+// A crossing only counts after x has been below mean - hysteresis, so
+// numerical ripple around the mean is not taken for a beat.
+static double beatPeriod(const std::vector<float>& x) {
+    if (x.size() < 4) return 0.0;
+
+    double mean = 0.0, var = 0.0;
+    for (float v : x) mean += v;
+    mean /= x.size();
+    for (float v : x) var += (v - mean) * (v - mean);
+    double hysteresis = 0.1 * std::sqrt(var / x.size());
+    if (hysteresis <= 0.0) return 0.0;
+
+    int first = -1, last = -1, crossings = 0;
+    bool armed = false;
+    for (size_t i = 0; i < x.size(); i++) {
+        if (x[i] < mean - hysteresis) {
+            armed = true;
+        } else if (armed && x[i] > mean) {
+            armed = false;
+            if (first < 0) first = static_cast<int>(i);
+            last = static_cast<int>(i);
+            crossings++;
+        }
+    }
+    return crossings >= 2 ? static_cast<double>(last - first) / (crossings - 1) : 0.0;
+}
+
+static void runPoint(const SweepConfig& config, const SweepPoint& p, float* row) {
+    DenormalGuard guard;  // Per thread: stepFused alone does not set it
+
+    SympatheticStrings sim;
+    sim.setImplicit(config.implicit);
+    sim.setString1Frequency(config.f1);
+    sim.setString2Frequency(config.f1 * p.ratio);
+    sim.setBridgeStiffness(p.stiffness);
+    sim.setDamping(p.damping);
+    sim.pluck(0, config.pluckPos, 0.5f);
+
+    float initial = sim.getTotalEnergy();
+    int readings = static_cast<int>(config.seconds * SAMPLE_RATE / METRIC_SAMPLES);
+    float interval = static_cast<float>(METRIC_SAMPLES) / SAMPLE_RATE;
+
+    float peakRatio = 0.0f, peakTime = 0.0f;
+    std::vector<float> share;
+    share.reserve(readings);
+
+    for (int k = 1; k <= readings; k++) {
+        sim.stepFused(METRIC_SAMPLES * OVERSAMPLING);
+
+        float e1 = sim.getEnergy1();
+        float e2 = sim.getEnergy2();
+        if (e1 + e2 < ACTIVE_FRACTION * initial) break;
+
+        if (e1 > 0.0f && e2 / e1 > peakRatio) {
+            peakRatio = e2 / e1;
+            peakTime = k * interval;
+        }
+        share.push_back(e2 / (e1 + e2));
+    }
+
+    const float values[NUM_COLUMNS] = {
+        p.ratio, p.stiffness, p.damping, sim.getString1Frequency(), sim.getString2Frequency(),
+        peakRatio, peakTime, static_cast<float>(beatPeriod(share) * interval),
+        sim.getEnergy1(), sim.getEnergy2()
+    };
+    std::memcpy(row, values, sizeof(values));
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+static bool endsWith(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+static bool writeCsv(const std::string& path, const std::vector<float>& table, int rows) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    for (int c = 0; c < NUM_COLUMNS; c++) {
+        std::fprintf(f, "%s%c", COLUMNS[c], c + 1 < NUM_COLUMNS ? ',' : '\n');
+    }
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < NUM_COLUMNS; c++) {
+            std::fprintf(f, "%.7g%c", table[r * NUM_COLUMNS + c], c + 1 < NUM_COLUMNS ? ',' : '\n');
+        }
+    }
+    return std::fclose(f) == 0;
+}
+
+static bool writeBinary(const std::string& path, const std::vector<float>& table, int rows) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    std::string names;
+    for (int c = 0; c < NUM_COLUMNS; c++) {
+        if (c > 0) names += ',';
+        names += COLUMNS[c];
+    }
+    const uint32_t header[4] = {
+        SWEEP_VERSION, static_cast<uint32_t>(NUM_COLUMNS), static_cast<uint32_t>(rows),
+        static_cast<uint32_t>(names.size())
+    };
+
+    bool ok = std::fwrite("SSWP", 1, 4, f) == 4
+           && std::fwrite(header, sizeof(header), 1, f) == 1
+           && std::fwrite(names.data(), 1, names.size(), f) == names.size()
+           && std::fwrite(table.data(), sizeof(float), table.size(), f) == table.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+// ============================================================================
+// Command line
+// ============================================================================
+static void usage() {
+    std::fprintf(stderr,
+        "usage: sympathetic-sweep [options]\n"
+        "  --ratio A:B:N       f2 / f1 values (default 1:2:11)\n"
+        "  --stiffness A:B:N   bridge stiffness values (default 1)\n"
+        "  --damping A:B:N     damping values (default 1e-5)\n"
+        "  --f1 HZ             string 1 frequency (default 220)\n"
+        "  --seconds S         simulated time per point (default 2)\n"
+        "  --pluck POS         pluck position on string 1, 0.1..0.9 (default 0.3)\n"
+        "  --implicit          implicit θ-scheme instead of the explicit leapfrog\n"
+        "  --threads N         worker threads (default: every core)\n"
+        "  --out FILE          results, .csv or .bin (default sweep.csv)\n");
+}
+
+static bool parseArgs(int argc, char** argv, SweepConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--implicit") {
+            config.implicit = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        const char* value = argv[++i];
+
+        bool ok = true;
+        if (arg == "--ratio") ok = parseAxis(value, config.ratio);
+        else if (arg == "--stiffness") ok = parseAxis(value, config.stiffness);
+        else if (arg == "--damping") ok = parseAxis(value, config.damping);
+        else if (arg == "--f1") config.f1 = std::strtof(value, nullptr);
+        else if (arg == "--seconds") config.seconds = std::strtof(value, nullptr);
+        else if (arg == "--pluck") config.pluckPos = std::strtof(value, nullptr);
+        else if (arg == "--threads") config.threads = std::atoi(value);
+        else if (arg == "--out") config.out = value;
+        else ok = false;
+
+        if (!ok) return false;
+    }
+    return config.seconds > 0.0f && config.f1 > 0.0f;
+}
+
+int main(int argc, char** argv) {
+    SweepConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        usage();
+        return 1;
+    }
+
+    const int points = config.points();
+    const int threads = config.threads > 0 ? config.threads : defaultThreadCount();
+    std::vector<float> table(static_cast<size_t>(points) * NUM_COLUMNS);
+
+    auto start = std::chrono::steady_clock::now();
+    runParallel(points, threads, [&](int i) {
+        runPoint(config, pointAt(config, i), &table[static_cast<size_t>(i) * NUM_COLUMNS]);
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool ok = endsWith(config.out, ".bin") ? writeBinary(config.out, table, points)
+                                           : writeCsv(config.out, table, points);
+    if (!ok) {
+        std::fprintf(stderr, "sympathetic-sweep: cannot write %s\n", config.out.c_str());
+        return 1;
+    }
+
+    std::fprintf(stderr, "%d points on %d threads in %.2f s (%.1f points/s, %.0fx realtime) -> %s\n",
+                 points, threads, seconds, points / seconds,
+                 points * config.seconds / seconds, config.out.c_str());
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * WAV Writer - buffered stereo WAV output for offline renders
+ *
+ * Frames are interleaved and converted into a fixed buffer, which goes to
+ * disk with one fwrite per WAV_BUFFER_BYTES, so an hour of audio costs a
+ * few thousand system calls. The RIFF and data sizes are unknown until the
+ * end, so they are written as 0 and patched by close().
+ *
+ *   Float32: WAVE_FORMAT_IEEE_FLOAT (3), samples as written
+ *   Pcm24:   WAVE_FORMAT_PCM (1), clamped to [-1, 1] and rounded
+ *
+ * Little-endian hosts only (every platform the native build targets).
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+constexpr size_t WAV_BUFFER_BYTES = 1 << 20;
+
+enum class WavFormat { Float32, Pcm24 };
+
+class WavWriter {
+public:
+    ~WavWriter() { close(); }
+
+    bool open(const std::string& path, WavFormat fmt, int sampleRate) {
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+
+        format = fmt;
+        rate = sampleRate;
+        frames = 0;
+        failed = false;
+        buffer.resize(WAV_BUFFER_BYTES);
+        used = 0;
+        writeHeader();
+        return !failed;
+    }
+
+    void write(const float* left, const float* right, int numFrames) {
+        const size_t frameBytes = 2 * bytesPerSample();
+        for (int i = 0; i < numFrames; i++) {
+            if (used + frameBytes > buffer.size()) flush();
+            putSample(left[i]);
+            putSample(right[i]);
+        }
+        frames += numFrames;
+    }
+
+    // Flushes, patches the sizes and closes; false if anything failed
+    bool close() {
+        if (!file) return !failed;
+
+        flush();
+        uint64_t dataBytes = frames * 2 * bytesPerSample();
+        uint32_t data32 = static_cast<uint32_t>(std::min<uint64_t>(dataBytes, UINT32_MAX));
+        uint32_t riff32 = static_cast<uint32_t>(std::min<uint64_t>(dataBytes + HEADER_BYTES - 8,
+                                                                   UINT32_MAX));
+        failed |= dataBytes + HEADER_BYTES > UINT32_MAX;  // Past the RIFF limit (see maxFrames)
+
+        failed |= std::fseek(file, 4, SEEK_SET) != 0 || std::fwrite(&riff32, 4, 1, file) != 1;
+        failed |= std::fseek(file, HEADER_BYTES - 4, SEEK_SET) != 0
+               || std::fwrite(&data32, 4, 1, file) != 1;
+        failed |= std::fclose(file) != 0;
+        file = nullptr;
+        return !failed;
+    }
+
+    uint64_t framesWritten() const { return frames; }
+
+    // Longest stereo file the 32-bit RIFF sizes can describe (at 44.1 kHz
+    // about 3.4 h float, 4.5 h pcm24)
+    static uint64_t maxFrames(WavFormat fmt) {
+        return (UINT32_MAX - HEADER_BYTES) / (2 * sampleBytes(fmt));
+    }
+
+private:
+    static constexpr long HEADER_BYTES = 44;
+
+    FILE* file = nullptr;
+    WavFormat format = WavFormat::Float32;
+    int rate = 44100;
+    uint64_t frames = 0;
+    bool failed = false;
+    std::vector<uint8_t> buffer;
+    size_t used = 0;
+
+    static size_t sampleBytes(WavFormat fmt) { return fmt == WavFormat::Float32 ? 4 : 3; }
+    size_t bytesPerSample() const { return sampleBytes(format); }
+
+    void putSample(float x) {
+        uint8_t* out = buffer.data() + used;
+        if (format == WavFormat::Float32) {
+            std::memcpy(out, &x, 4);
+            used += 4;
+            return;
+        }
+
+        x = std::max(-1.0f, std::min(1.0f, std::isfinite(x) ? x : 0.0f));
+        int32_t v = static_cast<int32_t>(std::lrint(x * 8388607.0f));
+        out[0] = static_cast<uint8_t>(v);
+        out[1] = static_cast<uint8_t>(v >> 8);
+        out[2] = static_cast<uint8_t>(v >> 16);
+        used += 3;
+    }
+
+    void flush() {
+        if (used > 0 && std::fwrite(buffer.data(), 1, used, file) != used) failed = true;
+        used = 0;
+    }
+
+    void writeHeader() {
+        const uint16_t formatTag = format == WavFormat::Float32 ? 3 : 1;
+        const uint16_t channels = 2;
+        const uint16_t bits = static_cast<uint16_t>(8 * bytesPerSample());
+        const uint16_t blockAlign = static_cast<uint16_t>(channels * bytesPerSample());
+        const uint32_t byteRate = static_cast<uint32_t>(rate) * blockAlign;
+        const uint32_t fmtSize = 16, zero = 0, sampleRate = static_cast<uint32_t>(rate);
+
+        failed |= std::fwrite("RIFF", 1, 4, file) != 4 || std::fwrite(&zero, 4, 1, file) != 1
+               || std::fwrite("WAVEfmt ", 1, 8, file) != 8 || std::fwrite(&fmtSize, 4, 1, file) != 1
+               || std::fwrite(&formatTag, 2, 1, file) != 1 || std::fwrite(&channels, 2, 1, file) != 1
+               || std::fwrite(&sampleRate, 4, 1, file) != 1 || std::fwrite(&byteRate, 4, 1, file) != 1
+               || std::fwrite(&blockAlign, 2, 1, file) != 1 || std::fwrite(&bits, 2, 1, file) != 1
+               || std::fwrite("data", 1, 4, file) != 4 || std::fwrite(&zero, 4, 1, file) != 1;
+    }
+};
@@ -0,0 +1,96 @@
+/**
+ * Work Stealing - thread pool for independent simulation runs
+ *
+ * runParallel(count, threads, task) calls task(i) once for every i in
+ * [0, count), spread over `threads` workers:
+ *
+ *   worker 0   [ 0  1  2  3 ]  <- pops from the front of its own deque
+ *   worker 1   [ 4  5  6  7 ]
+ *   worker 2   [ 8  9 10 11 ]  -> an idle worker steals from the back of
+ *                                 another's deque
+ *
+ * Every worker starts with a contiguous share of the indices. Runs differ a
+ * lot in cost (high strings need more substeps, a sleeping pair costs almost
+ * nothing), so a worker that runs dry steals the last index of the next
+ * worker that still has one instead of waiting. Tasks are whole simulations
+ * (milliseconds each), so a mutex per deque is far below the noise; what
+ * matters is that no core idles while another still has a queue.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingQueue {
+public:
+    void push(int index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.push_back(index);
+    }
+
+    // Owner side: next index in order
+    bool pop(int& index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.empty()) return false;
+        index = items.front();
+        items.pop_front();
+        return true;
+    }
+
+    // Thief side: the index the owner would reach last
+    bool steal(int& index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.empty()) return false;
+        index = items.back();
+        items.pop_back();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::deque<int> items;
+};
+
+// Workers to use when the caller asks for 0: every hardware thread
+inline int defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+template <typename Task>
+inline void runParallel(int count, int threads, Task task) {
+    if (threads <= 0) threads = defaultThreadCount();
+    threads = std::max(1, std::min(threads, count));
+    if (count <= 0) return;
+
+    std::vector<WorkStealingQueue> queues(threads);
+    for (int i = 0; i < count; i++) {
+        queues[static_cast<size_t>(i) * threads / count].push(i);
+    }
+
+    auto worker = [&](int self) {
+        int index;
+        for (;;) {
+            if (queues[self].pop(index)) {
+                task(index);
+                continue;
+            }
+
+            // Own deque empty: try every other worker once, nearest first
+            bool stolen = false;
+            for (int k = 1; k < threads && !stolen; k++) {
+                stolen = queues[(self + k) % threads].steal(index);
+            }
+            if (!stolen) return;  // Nothing left anywhere: tasks never add work
+            task(index);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (std::thread& t : pool) t.join();
+}
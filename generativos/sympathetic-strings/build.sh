@@ -5,17 +5,37 @@ echo "Building Sympathetic Strings Physics Simulation..."
 
 mkdir -p web
 
-em++ src/physics.cpp \
-    -o web/physics.js \
-    -s WASM=1 \
-    -s MODULARIZE=1 \
-    -s EXPORT_NAME="createPhysicsModule" \
-    -s ALLOW_MEMORY_GROWTH=1 \
-    -s ENVIRONMENT='web' \
-    -lembind \
-    -O3 \
+FLAGS=(
+    -s WASM=1
+    -s MODULARIZE=1
+    -s EXPORT_NAME="createPhysicsModule"
+    -s ALLOW_MEMORY_GROWTH=1
+    -s ENVIRONMENT='web'
+    -s EXPORTED_FUNCTIONS='["_malloc","_free"]'
+    -s EXPORTED_RUNTIME_METHODS='["HEAPF32"]'
+    -lembind
+    -O3
     --no-entry
+)
+
+# Baseline build (scalar kernels)
+em++ src/physics.cpp -o web/physics.js "${FLAGS[@]}"
+
+# SIMD128 build, loaded instead when the browser supports wasm SIMD
+em++ src/physics.cpp -o web/physics-simd.js "${FLAGS[@]}" -msimd128
+
+# Threaded build: PhysicsWorker renders on a pthread into a ring in shared
+# memory. Needs SharedArrayBuffer, so the page only loads it when
+# cross-origin isolated (COOP/COEP headers).
+em++ src/physics.cpp -o web/physics-mt.js "${FLAGS[@]}" -msimd128 -pthread \
+    -s PTHREAD_POOL_SIZE=1 \
+    -s ENVIRONMENT='web,worker' \
+    -s EXPORTED_RUNTIME_METHODS='["HEAPF32","HEAPU32"]'
 
 echo "Build complete!"
 echo "  web/physics.js"
 echo "  web/physics.wasm"
+echo "  web/physics-simd.js"
+echo "  web/physics-simd.wasm"
+echo "  web/physics-mt.js"
+echo "  web/physics-mt.wasm"
@@ -0,0 +1,322 @@
+/**
+ * Batch Strings - many independent rigid-bridge pairs stepped in lockstep
+ *
+ * Sweeps and ensembles run thousands of small SympatheticStrings that differ
+ * only in their parameters. Vectorizing one 200-point string along x leaves
+ * partial vectors at the ends and a scalar bridge per instance; here the
+ * vector runs across instances instead. Lane l of a BatchStrings<Lanes> is
+ * instance l, and every array is lane-interleaved:
+ *
+ *     y[i * Lanes + l]  =  point i of lane l
+ *
+ *     point 0    | l0 l1 l2 l3 l4 l5 l6 l7 |   <- one AVX2 vector
+ *     point 1    | l0 l1 l2 l3 l4 l5 l6 l7 |
+ *      ...
+ *     bridge     | b0 b1 b2 b3 b4 b5 b6 b7 |   <- bridge solve, lane-wise
+ *
+ * The interior update is the batchInterior stencil kernel (one vector per
+ * point row, each lane with its own Courant number and damping); commit is
+ * the regular kernel over the whole Points * Lanes array. The bridge solve is
+ * a short loop over lanes with no cross-lane traffic at all.
+ *
+ * Lockstep means one grid and one substep rate for the whole batch: they are
+ * fitted to the fastest string in any lane (courantSubsteps / courantPoints),
+ * so slower lanes run at a Courant number below the target. Lanes whose
+ * grid matches what SympatheticStrings picks for them step bit-identically
+ * to it (same kernels, same bridge arithmetic).
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <array>
+#include <algorithm>
+
+#include "physics.h"
+
+template <int Lanes, int Points = NUM_POINTS>
+class BatchStrings {
+    static_assert(Lanes == 4 || Lanes == 8 || Lanes == 16, "Lanes must be 4, 8 or 16");
+
+public:
+    // One string of every lane
+    struct BatchString {
+        alignas(64) std::array<float, Points * Lanes> y;
+        alignas(64) std::array<float, Points * Lanes> y_prev;
+        alignas(64) std::array<float, Points * Lanes> y_next;
+        alignas(64) std::array<float, Points * Lanes> v;
+
+        std::array<float, Lanes> frequency;
+        std::array<float, Lanes> tension;
+        std::array<float, Lanes> waveSpeed;
+        std::array<float, Lanes> damping;
+        float density = 0.001f;
+        float length = 1.0f;  // Normalized length
+
+        // Per substep, refreshed by fitGrid / setters
+        alignas(64) std::array<float, Lanes> rSq;
+        alignas(64) std::array<float, Lanes> stepDamping;
+    };
+
+    BatchString string1;
+    BatchString string2;
+
+    // Rigid bridge of every lane
+    std::array<float, Lanes> bridgeY;
+    std::array<float, Lanes> bridgePrevY;
+    std::array<float, Lanes> bridgeStiffness;
+    std::array<float, Lanes> stepStiffness;  // bridgeStiffness compounded over stride
+
+    float dt;
+    int64_t stepCount = 0;   // Base steps of dt; the clock
+    int numPoints = Points;  // Shared grid, bridge at numPoints - 1
+    int stride = 1;          // Base steps per substep, shared
+
+    const StencilKernels* kernels = &activeStencilKernels();
+
+    BatchStrings() {
+        dt = 1.0f / (SAMPLE_RATE * OVERSAMPLING);
+        clear(string1);
+        clear(string2);
+        bridgeY.fill(0.0f);
+        bridgePrevY.fill(0.0f);
+        bridgeStiffness.fill(1.0f);
+        string1.damping.fill(0.00001f);
+        string2.damping.fill(0.00001f);
+
+        // Same default as SympatheticStrings: C4 and G4
+        for (int l = 0; l < Lanes; l++) {
+            tune(string1, l, 261.63f);
+            tune(string2, l, 392.00f);
+        }
+        fitGrid();
+    }
+
+    // ========================================================================
+    // Per-lane parameters
+    // ========================================================================
+    void setFrequencies(int lane, float f1, float f2) {
+        tune(string1, lane, std::max(50.0f, std::min(1000.0f, f1)));
+        tune(string2, lane, std::max(50.0f, std::min(1000.0f, f2)));
+        fitGrid();
+    }
+
+    void setDamping(int lane, float d) {
+        float damping = std::max(0.0f, std::min(0.01f, d));
+        string1.damping[lane] = damping;
+        string2.damping[lane] = damping;
+        updateCoefficients();
+    }
+
+    void setBridgeStiffness(int lane, float s) {
+        bridgeStiffness[lane] = std::max(0.0f, std::min(1.0f, s));
+        updateCoefficients();
+    }
+
+    // Triangular pluck of one string of one lane (see SympatheticStrings)
+    void pluck(int lane, int stringIndex, float position, float amplitude) {
+        BatchString& s = (stringIndex == 0) ? string1 : string2;
+
+        position = std::max(0.1f, std::min(0.9f, position));
+        amplitude = std::max(0.0f, std::min(1.0f, amplitude));
+
+        const int N = numPoints;
+        for (int i = 0; i < N; i++) {
+            float x = static_cast<float>(i) / (N - 1);
+            float y = x < position ? amplitude * x / position
+                                   : amplitude * (1.0f - x) / (1.0f - position);
+            s.y[i * Lanes + lane] = y;
+            s.y_prev[i * Lanes + lane] = y;
+            s.v[i * Lanes + lane] = 0.0f;
+        }
+        s.y[lane] = 0.0f;
+        s.y_prev[lane] = 0.0f;
+    }
+
+    // ========================================================================
+    // Stepping
+    // ========================================================================
+    // Advances every lane by numSteps base steps (dt each); a substep runs
+    // whenever a stride of base steps completes
+    void step(int numSteps) {
+        DenormalGuard guard;
+        for (int n = 0; n < numSteps; n++) {
+            if ((stepCount + 1) % stride == 0) substep();
+            stepCount++;
+        }
+    }
+
+    // One sample per frame for every lane, at the same pickup as
+    // SympatheticStrings::renderBlock. outL/outR hold numFrames * Lanes
+    // floats, lane-interleaved like the grid.
+    void renderBlock(int numFrames, float pickupPos, float* outL, float* outR) {
+        pickupPos = std::max(0.0f, std::min(1.0f, pickupPos));
+        int pickup = std::min(numPoints - 1, static_cast<int>(pickupPos * numPoints));
+        const float* y1 = string1.y.data() + pickup * Lanes;
+        const float* y2 = string2.y.data() + pickup * Lanes;
+
+        for (int i = 0; i < numFrames; i++) {
+            step(OVERSAMPLING);
+
+            for (int l = 0; l < Lanes; l++) {
+                float s1 = y1[l] * PICKUP_GAIN;
+                float s2 = y2[l] * PICKUP_GAIN;
+                outL[i * Lanes + l] = s1 * STEREO_MIX + s2 * (1.0f - STEREO_MIX);
+                outR[i * Lanes + l] = s1 * (1.0f - STEREO_MIX) + s2 * STEREO_MIX;
+            }
+        }
+    }
+
+    // Seconds simulated, from the step count as in SympatheticStrings
+    float getTime() const {
+        return static_cast<float>(static_cast<double>(stepCount) / (static_cast<double>(SAMPLE_RATE) * OVERSAMPLING));
+    }
+
+    // ========================================================================
+    // Energy (computed on demand, one lane at a time)
+    // ========================================================================
+    float getEnergy1(int lane) const { return energy(string1, lane); }
+    float getEnergy2(int lane) const { return energy(string2, lane); }
+    float getBridgeY(int lane) const { return bridgeY[lane]; }
+    int getNumPoints() const { return numPoints; }
+    int getSubsteps() const { return OVERSAMPLING / stride; }
+
+    // Copies one lane's string displacement out (numPoints values)
+    void getDisplacement(int lane, int stringIndex, float* out) const {
+        const BatchString& s = (stringIndex == 0) ? string1 : string2;
+        for (int i = 0; i < numPoints; i++) out[i] = s.y[i * Lanes + lane];
+    }
+
+private:
+    static void clear(BatchString& s) {
+        s.y.fill(0.0f);
+        s.y_prev.fill(0.0f);
+        s.y_next.fill(0.0f);
+        s.v.fill(0.0f);
+    }
+
+    // Same tuning law as StringState::setFrequency
+    static void tune(BatchString& s, int lane, float freq) {
+        s.frequency[lane] = freq;
+        s.tension[lane] = 4.0f * s.density * s.length * s.length * freq * freq;
+        s.waveSpeed[lane] = std::sqrt(s.tension[lane] / s.density);
+    }
+
+    // One substep of stride base steps for every lane: interior, bridge,
+    // commit - the single-rate scheme of SympatheticStrings::stepExplicit
+    void substep() {
+        const int N = numPoints;
+        const float stepDt = dt * stride;
+
+        kernels->batchInterior(string1.y.data(), string1.y_prev.data(), string1.y_next.data(),
+                               N, Lanes, string1.rSq.data(), string1.stepDamping.data(), stepDt);
+        kernels->batchInterior(string2.y.data(), string2.y_prev.data(), string2.y_next.data(),
+                               N, Lanes, string2.rSq.data(), string2.stepDamping.data(), stepDt);
+
+        const float* n1 = string1.y.data() + (N - 2) * Lanes;
+        const float* n2 = string2.y.data() + (N - 2) * Lanes;
+        float* end1 = string1.y_next.data() + (N - 1) * Lanes;
+        float* end2 = string2.y_next.data() + (N - 1) * Lanes;
+
+        for (int l = 0; l < Lanes; l++) {
+            float b = bridgeY[l];
+            float bp = bridgePrevY[l];
+            float want1 = 2.0f * b - bp + string1.rSq[l] * (n1[l] - 2.0f * b + b)
+                        - string1.damping[l] * stride * stepDt * (b - bp) / stepDt;
+            float want2 = 2.0f * b - bp + string2.rSq[l] * (n2[l] - 2.0f * b + b)
+                        - string2.damping[l] * stride * stepDt * (b - bp) / stepDt;
+
+            float totalTension = string1.tension[l] + string2.tension[l];
+            float newB = (string1.tension[l] * want1 + string2.tension[l] * want2) / totalTension;
+            newB = stepStiffness[l] * newB + (1.0f - stepStiffness[l]) * b;
+            newB = std::max(-0.5f, std::min(0.5f, newB));
+            if (!std::isfinite(newB)) newB = 0.0f;
+
+            bridgePrevY[l] = b;
+            bridgeY[l] = newB;
+            end1[l] = newB;
+            end2[l] = newB;
+        }
+
+        kernels->commit(string1.y.data(), string1.y_prev.data(), string1.v.data(),
+                        string1.y_next.data(), N * Lanes, stepDt);
+        kernels->commit(string2.y.data(), string2.y_prev.data(), string2.v.data(),
+                        string2.y_next.data(), N * Lanes, stepDt);
+    }
+
+    // Shared substep rate and grid for the fastest string in the batch; the
+    // shapes are resampled and velocities kept as in SympatheticStrings::fitGrid
+    void fitGrid() {
+        float fastest = 0.0f;
+        for (int l = 0; l < Lanes; l++) {
+            fastest = std::max({fastest, string1.waveSpeed[l], string2.waveSpeed[l]});
+        }
+        int newStride = OVERSAMPLING / courantSubsteps(fastest, string1.length, Points);
+        int n = courantPoints(fastest, string1.length, dt * newStride, Points);
+
+        if (newStride != stride) {
+            float scale = static_cast<float>(newStride) / stride;
+            for (BatchString* s : {&string1, &string2}) {
+                for (int j = 0; j < numPoints * Lanes; j++) {
+                    s->y_prev[j] = s->y[j] - (s->y[j] - s->y_prev[j]) * scale;
+                }
+            }
+            stride = newStride;
+        }
+        if (n != numPoints) {
+            for (BatchString* s : {&string1, &string2}) {
+                resampleLanes(s->y.data(), n);
+                resampleLanes(s->y_prev.data(), n);
+                resampleLanes(s->v.data(), n);
+            }
+            numPoints = n;
+        }
+        updateCoefficients();
+    }
+
+    void resampleLanes(float* data, int n) {
+        std::array<float, Points> column;
+        for (int l = 0; l < Lanes; l++) {
+            for (int i = 0; i < numPoints; i++) column[i] = data[i * Lanes + l];
+            resampleGrid<Points>(column.data(), numPoints, n);
+            for (int i = 0; i < n; i++) data[i * Lanes + l] = column[i];
+        }
+    }
+
+    // Per-lane Courant numbers, damping and stiffness for the current grid
+    // (same expressions as SympatheticStrings::courantSq / substepDamping /
+    // settleBridge)
+    void updateCoefficients() {
+        float dx = string1.length / (numPoints - 1);
+        for (BatchString* s : {&string1, &string2}) {
+            for (int l = 0; l < Lanes; l++) {
+                float r = s->waveSpeed[l] * (dt * stride) / dx;
+                s->rSq[l] = r * r;
+                s->stepDamping[l] = s->damping[l] * stride;
+            }
+        }
+        for (int l = 0; l < Lanes; l++) {
+            stepStiffness[l] = bridgeStiffness[l];
+            if (stride > 1) {
+                stepStiffness[l] = 1.0f - std::pow(1.0f - bridgeStiffness[l],
+                                                   static_cast<float>(stride));
+            }
+        }
+    }
+
+    float energy(const BatchString& s, int lane) const {
+        const int N = numPoints;
+        float dx = s.length / (N - 1);
+        float ke = 0.0f, pe = 0.0f;
+        for (int i = 0; i < N; i++) {
+            float v = s.v[i * Lanes + lane];
+            ke += 0.5f * s.density * dx * v * v;
+            if (i < N - 1) {
+                float strain = (s.y[(i + 1) * Lanes + lane] - s.y[i * Lanes + lane]) / dx;
+                pe += 0.5f * s.tension[lane] * strain * strain * dx;
+            }
+        }
+        return ke + pe;
+    }
+};
@@ -0,0 +1,68 @@
+/**
+ * History Ring - fixed-capacity history of one scalar signal
+ *
+ * Storage is allocated once (setCapacity) and recording is O(1): once full,
+ * the newest value overwrites the oldest. Contents are exported without
+ * copying as two contiguous spans, oldest first:
+ *
+ *   storage:  [ 6 7 8 | 3 4 5 ]      head = 3 4 5   (start .. end of storage)
+ *                       ^ start      tail = 6 7 8   (storage begin .. newest)
+ *
+ * Until the ring wraps, the tail is empty.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+class HistoryRing {
+public:
+    explicit HistoryRing(size_t capacity) { setCapacity(capacity); }
+
+    // Reallocates and clears; spans handed out before are invalidated
+    void setCapacity(size_t capacity) {
+        buffer.assign(capacity > 0 ? capacity : 1, 0.0f);
+        clear();
+    }
+
+    void clear() {
+        start = 0;
+        count = 0;
+    }
+
+    void push(float value) {
+        size_t cap = buffer.size();
+        if (count < cap) {
+            buffer[(start + count) % cap] = value;
+            count++;
+        } else {
+            buffer[start] = value;
+            start = (start + 1) % cap;
+        }
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return buffer.size(); }
+
+    // Oldest-first as [head, tail]
+    const float* headData() const { return buffer.data() + start; }
+    size_t headSize() const { return std::min(count, buffer.size() - start); }
+    const float* tailData() const { return buffer.data(); }
+    size_t tailSize() const { return count - headSize(); }
+
+    // i-th oldest value
+    float operator[](size_t i) const { return buffer[(start + i) % buffer.size()]; }
+
+    std::vector<float> toVector() const {
+        std::vector<float> out(headData(), headData() + headSize());
+        out.insert(out.end(), tailData(), tailData() + tailSize());
+        return out;
+    }
+
+private:
+    std::vector<float> buffer;
+    size_t start = 0;
+    size_t count = 0;
+};
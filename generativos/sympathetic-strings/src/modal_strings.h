@@ -0,0 +1,633 @@
+/**
+ * Modal Strings - modal synthesis of the rigid-bridge two-string model
+ *
+ * Same physics as SympatheticStrings (physics.h), solved in the frequency
+ * domain instead of on a grid. Below a few kHz the FDTD grid only carries a
+ * few dozen audible modes, and each of them is a damped oscillator that can
+ * be advanced exactly, once per audio sample, with a two-pole recursion:
+ *
+ *   q[n+1] = a1 * q[n] - a2 * q[n-1]
+ *
+ * Coupled modes:
+ *   The bridge is not fed back into each string's own sine modes sample by
+ *   sample. Instead the junction is solved once per parameter change: every
+ *   mode is a sine on string 1 and a sine on string 2 that meet at the
+ *   bridge. solveBridge() averages what each string wants with weights
+ *   w = T / (T1 + T2), and each want moves by T * slope, so as dx -> 0 the
+ *   FDTD bridge obeys
+ *
+ *     y1 = A1 sin(k1 x),  y2 = A2 sin(k2 x),  y1(L) = y2(L) = bridge
+ *     w1 T1 y1'(L) + w2 T2 y2'(L) + K * bridge = 0
+ *
+ *   Dividing by y1(L) leaves  w1 T1 k1 cot(k1 L) + w2 T2 k2 cot(k2 L) + K = 0,
+ *   which decreases monotonically between consecutive harmonics of either
+ *   string, so each such interval holds exactly one mode (found by
+ *   bisection). The modes are orthogonal under the w-weighted mass product,
+ *   which is what projections use. The bridge displacement is the sum of
+ *   every mode's value at x = L, and energy moves between the strings
+ *   because each mode lives on both of them.
+ *
+ * Bridge stiffness maps to a spring from the bridge to ground:
+ *   K = (w1 T1 + w2 T2) / L * (1 - s) / s
+ *   s = 1 is the free rigid junction of the FDTD model, s -> 0 clamps the
+ *   bridge and decouples the strings. In between it is a perceptual match
+ *   for the FDTD's per-substep blend, not the same dynamics.
+ *
+ * Plucks and parameter changes reconstruct the displacement and velocity on
+ * the NUM_POINTS grid, rebuild the modes if needed and project back. The
+ * modes stop at MODAL_MAX_FREQUENCY, so a pluck loses its (tiny) energy
+ * above that, and the FDTD's bridge clamp is not modelled. The grid arrays in
+ * string1 / string2 are only filled when someone asks for them.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include "physics.h"
+
+constexpr int MODAL_MAX_MODES = 256;
+constexpr float MODAL_MAX_FREQUENCY = 10000.0f;  // Hz, highest mode kept
+constexpr int MODAL_LANES = 8;                    // Modes per group in advanceModes()
+
+// ============================================================================
+// Modal Strings Simulation
+// ============================================================================
+class ModalStrings {
+public:
+    // Parameters, energies and the lazily reconstructed y / v grids
+    StringState string1;
+    StringState string2;
+
+    float bridgeY;
+    float bridgeV;
+    float bridgeStiffness;
+
+    // Simulation (one step = one audio sample, there are no substeps)
+    float dt;
+    int64_t stepCount;
+
+    HistoryRing energy1History{HISTORY_LENGTH};
+    HistoryRing energy2History{HISTORY_LENGTH};
+    HistoryRing bridgeHistory{HISTORY_LENGTH};
+    int historyInterval = HISTORY_INTERVAL;
+
+    // Energy sums over the reconstructed grid
+    const StencilKernels* kernels = &activeStencilKernels();
+
+    bool energyDirty = false;
+    bool displacementDirty = false;
+    bool energyDiagnostics = false;
+    float maxTotalEnergy = 0.0f;
+
+    // Modes (SoA, MODAL_MAX_MODES capacity allocated once)
+    int numModes = 0;
+    std::vector<float> modeFrequency;
+    std::vector<float> modeMass;     // Weighted mass norm on the grid
+    std::vector<float> a1, a2;       // Two-pole recursion
+    std::vector<float> q, qPrev;     // Modal amplitudes at n and n-1
+    std::vector<float> velCur, velPrev;    // dq/dt = velCur*q - velPrev*qPrev
+    std::vector<float> backPos, backVel;   // q[n-1] = backPos*q - backVel*dq/dt
+    std::vector<float> shape1, shape2;     // Mode shapes, [mode * NUM_POINTS + i]
+    std::vector<float> modeVelocity;       // Scratch for setDamping()
+
+    // Mode shapes at the pickup, refreshed when the pickup point changes
+    std::vector<float> pickup1, pickup2;
+    int pickupIndex = -1;
+
+    ModalStrings()
+        : modeFrequency(MODAL_MAX_MODES), modeMass(MODAL_MAX_MODES),
+          a1(MODAL_MAX_MODES), a2(MODAL_MAX_MODES),
+          q(MODAL_MAX_MODES), qPrev(MODAL_MAX_MODES),
+          velCur(MODAL_MAX_MODES), velPrev(MODAL_MAX_MODES),
+          backPos(MODAL_MAX_MODES), backVel(MODAL_MAX_MODES),
+          shape1(MODAL_MAX_MODES * NUM_POINTS), shape2(MODAL_MAX_MODES * NUM_POINTS),
+          modeVelocity(MODAL_MAX_MODES),
+          pickup1(MODAL_MAX_MODES), pickup2(MODAL_MAX_MODES) {
+        dt = 1.0f / SAMPLE_RATE;
+        stepCount = 0;
+
+        bridgeY = 0.0f;
+        bridgeV = 0.0f;
+        bridgeStiffness = 1.0f;
+
+        // Default: C4 and G4 (perfect fifth, ratio 3:2)
+        string1.setFrequency(261.63f);
+        string2.setFrequency(392.00f);
+        buildModes();
+    }
+
+    // ========================================================================
+    // Pluck a string
+    // ========================================================================
+    // Same triangular shape as SympatheticStrings::pluck(), at rest; the
+    // other string keeps its motion. The new field is projected onto the modes.
+    void pluck(int stringIndex, float position, float amplitude) {
+        StringState& s = (stringIndex == 0) ? string1 : string2;
+
+        position = std::max(0.1f, std::min(0.9f, position));
+        amplitude = std::max(0.0f, std::min(1.0f, amplitude));
+
+        updateDisplacement();
+
+        for (int i = 0; i < NUM_POINTS; i++) {
+            float x = static_cast<float>(i) / (NUM_POINTS - 1);
+
+            if (x < position) {
+                s.y[i] = amplitude * x / position;
+            } else {
+                s.y[i] = amplitude * (1.0f - x) / (1.0f - position);
+            }
+            s.v[i] = 0.0f;
+        }
+        s.y[0] = 0.0f;
+
+        projectState();
+    }
+
+    // ========================================================================
+    // Physics Step (one audio sample per step)
+    // ========================================================================
+    void step(int numSteps = 1) {
+        for (int n = 0; n < numSteps; n++) {
+            float s1, s2;
+            advanceModes(s1, s2);
+            advanceClock();
+        }
+    }
+
+    // ========================================================================
+    // Block Rendering
+    // ========================================================================
+    // Same pickup, gain and stereo mix as SympatheticStrings::renderBlock()
+    void renderBlock(int numFrames, float pickupPos, float* outL, float* outR) {
+        pickupPos = std::max(0.0f, std::min(1.0f, pickupPos));
+        setPickup(std::min(NUM_POINTS - 1, static_cast<int>(pickupPos * NUM_POINTS)));
+
+        for (int i = 0; i < numFrames; i++) {
+            float s1, s2;
+            advanceModes(s1, s2);
+
+            s1 *= PICKUP_GAIN;
+            s2 *= PICKUP_GAIN;
+
+            outL[i] = s1 * STEREO_MIX + s2 * (1.0f - STEREO_MIX);
+            outR[i] = s1 * (1.0f - STEREO_MIX) + s2 * STEREO_MIX;
+
+            advanceClock();
+        }
+    }
+
+    // One sample of every mode; s1 / s2 are the strings at the pickup.
+    // Modes run in groups of MODAL_LANES with one partial sum per lane so
+    // the loop vectorizes; slots past numModes are all zero.
+    void advanceModes(float& s1, float& s2) {
+        float acc1[MODAL_LANES] = {};
+        float acc2[MODAL_LANES] = {};
+        const float* __restrict c1 = a1.data();
+        const float* __restrict c2 = a2.data();
+        const float* __restrict w1 = pickup1.data();
+        const float* __restrict w2 = pickup2.data();
+        float* __restrict cur = q.data();
+        float* __restrict prev = qPrev.data();
+
+        int count = (numModes + MODAL_LANES - 1) / MODAL_LANES * MODAL_LANES;
+        for (int m0 = 0; m0 < count; m0 += MODAL_LANES) {
+            for (int l = 0; l < MODAL_LANES; l++) {
+                int m = m0 + l;
+                float next = c1[m] * cur[m] - c2[m] * prev[m];
+                prev[m] = cur[m];
+                cur[m] = next;
+                acc1[l] += next * w1[m];
+                acc2[l] += next * w2[m];
+            }
+        }
+        s1 = 0.0f;
+        s2 = 0.0f;
+        for (int l = 0; l < MODAL_LANES; l++) {
+            s1 += acc1[l];
+            s2 += acc2[l];
+        }
+    }
+
+    void advanceClock() {
+        markEnergyDirty();
+
+        stepCount++;
+
+        if (stepCount % historyInterval == 0) {
+            recordHistory();
+        }
+    }
+
+    void setPickup(int index) {
+        if (index == pickupIndex) return;
+        pickupIndex = index;
+        for (int m = 0; m < numModes; m++) {
+            pickup1[m] = shape1[m * NUM_POINTS + index];
+            pickup2[m] = shape2[m * NUM_POINTS + index];
+        }
+    }
+
+    // ========================================================================
+    // Modes
+    // ========================================================================
+    // Share of each string in the bridge average, as in solveBridge()
+    double junctionWeight(const StringState& s) const {
+        return s.tension / (string1.tension + string2.tension);
+    }
+
+    // Junction function divided by y(L): w1 T1 k1 cot(k1 L) + w2 T2 k2 cot(k2 L) + K.
+    // Decreasing from +inf to -inf between consecutive harmonics.
+    double junction(double f) const {
+        const double L = string1.length;
+        double k1L = PI * f / string1.frequency;
+        double k2L = PI * f / string2.frequency;
+        return junctionWeight(string1) * string1.tension * (k1L / L) / std::tan(k1L)
+             + junctionWeight(string2) * string2.tension * (k2L / L) / std::tan(k2L)
+             + bridgeSpring();
+    }
+
+    double bridgeSpring() const {
+        double s = std::max(1e-4, static_cast<double>(bridgeStiffness));
+        double stiffness = junctionWeight(string1) * string1.tension
+                         + junctionWeight(string2) * string2.tension;
+        return stiffness / string1.length * (1.0 - s) / s;
+    }
+
+    // Finds every mode below MODAL_MAX_FREQUENCY (and Nyquist) and sets up
+    // shapes, masses and recursion coefficients. Amplitudes are cleared.
+    void buildModes() {
+        const double f1 = string1.frequency;
+        const double f2 = string2.frequency;
+        const double fMax = std::min(static_cast<double>(MODAL_MAX_FREQUENCY), 0.45 * SAMPLE_RATE);
+
+        numModes = 0;
+        pickupIndex = -1;
+        std::fill(a1.begin(), a1.end(), 0.0f);
+        std::fill(a2.begin(), a2.end(), 0.0f);
+        std::fill(pickup1.begin(), pickup1.end(), 0.0f);
+        std::fill(pickup2.begin(), pickup2.end(), 0.0f);
+
+        // Harmonics of either string bound the intervals; merge both series
+        int j1 = 1, j2 = 1;
+        double lo = 0.0;
+        while (numModes < MODAL_MAX_MODES) {
+            double h1 = j1 * f1;
+            double h2 = j2 * f2;
+            double hi = std::min(h1, h2);
+            bool coincident = std::abs(h1 - h2) <= 1e-9 * hi;
+
+            double f = findRoot(lo, hi);
+            if (f >= fMax) break;
+            addMode(f, false);
+
+            // Both strings have a node at the bridge: extra mode with the
+            // bridge at rest, shared according to the force balance
+            if (coincident && hi < fMax && numModes < MODAL_MAX_MODES) {
+                addMode(hi, true);
+            }
+
+            if (h1 <= hi || coincident) j1++;
+            if (h2 <= hi || coincident) j2++;
+            lo = hi;
+        }
+
+        std::fill(q.begin(), q.end(), 0.0f);
+        std::fill(qPrev.begin(), qPrev.end(), 0.0f);
+        displacementDirty = true;
+        markEnergyDirty();
+    }
+
+    // The single root of junction() in (lo, hi)
+    double findRoot(double lo, double hi) const {
+        for (int iter = 0; iter < 60 && hi - lo > 1e-9 * hi; iter++) {
+            double mid = 0.5 * (lo + hi);
+            if (junction(mid) > 0.0) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        return 0.5 * (lo + hi);
+    }
+
+    void addMode(double f, bool coincident) {
+        const int N = NUM_POINTS;
+        const double L = string1.length;
+        const double dx = L / (N - 1);
+        const int m = numModes++;
+        const double w1 = junctionWeight(string1);
+        const double w2 = junctionWeight(string2);
+
+        double k1L = PI * f / string1.frequency;
+        double k2L = PI * f / string2.frequency;
+
+        // Amplitudes so that both strings meet at the bridge
+        double A1, A2;
+        if (coincident) {
+            A1 = w2 * string2.tension * (k2L / L) * std::cos(k2L);
+            A2 = -w1 * string1.tension * (k1L / L) * std::cos(k1L);
+        } else {
+            A1 = std::sin(k2L);
+            A2 = std::sin(k1L);
+        }
+        double scale = 1.0 / std::max(std::abs(A1), std::abs(A2));
+        A1 *= scale;
+        A2 *= scale;
+
+        double bridge = coincident ? 0.0 : 0.5 * (A1 * std::sin(k1L) + A2 * std::sin(k2L));
+
+        // Shapes and their weighted mass on each string (trapezoid rule)
+        double mass1 = 0.0, mass2 = 0.0;
+        for (int i = 0; i < N; i++) {
+            double x = static_cast<double>(i) / (N - 1);
+            double phi1 = (i == N - 1) ? bridge : A1 * std::sin(k1L * x);
+            double phi2 = (i == N - 1) ? bridge : A2 * std::sin(k2L * x);
+            shape1[m * N + i] = static_cast<float>(phi1);
+            shape2[m * N + i] = static_cast<float>(phi2);
+
+            double w = (i == 0 || i == N - 1) ? 0.5 * dx : dx;
+            mass1 += w * w1 * string1.density * phi1 * phi1;
+            mass2 += w * w2 * string2.density * phi2 * phi2;
+        }
+
+        modeFrequency[m] = static_cast<float>(f);
+        modeMass[m] = static_cast<float>(mass1 + mass2);
+        setModeDamping(m, mass1, mass2);
+    }
+
+    // Recursion coefficients for mode m. Damping is given per FDTD substep;
+    // as a decay rate it is damping / substep, shared out by where the mode's
+    // mass sits.
+    void setModeDamping(int m, double mass1, double mass2) {
+        const double substep = 1.0 / (SAMPLE_RATE * OVERSAMPLING);
+        const double T = dt;
+        double gamma = (string1.damping * mass1 + string2.damping * mass2)
+                     / (substep * (mass1 + mass2));
+        double sigma = 0.5 * gamma;
+        double omega = 2.0 * PI * modeFrequency[m];
+
+        // C = cos(wd T), S = sin(wd T) / wd (hyperbolic when overdamped)
+        double C, S;
+        double disc = omega * omega - sigma * sigma;
+        if (disc > 0.0) {
+            double wd = std::sqrt(disc);
+            C = std::cos(wd * T);
+            S = std::sin(wd * T) / wd;
+        } else if (disc < 0.0) {
+            double beta = std::sqrt(-disc);
+            C = std::cosh(beta * T);
+            S = std::sinh(beta * T) / beta;
+        } else {
+            C = 1.0;
+            S = T;
+        }
+
+        double decay = std::exp(-sigma * T);
+        a1[m] = static_cast<float>(2.0 * decay * C);
+        a2[m] = static_cast<float>(decay * decay);
+        velCur[m] = static_cast<float>((C - sigma * S) / S);
+        velPrev[m] = static_cast<float>(decay / S);
+        backPos[m] = static_cast<float>((C - sigma * S) / decay);
+        backVel[m] = static_cast<float>(S / decay);
+    }
+
+    // Grid y / v of both strings -> modal amplitudes (weighted projection)
+    void projectState() {
+        const int N = NUM_POINTS;
+        const float dx = string1.length / (N - 1);
+        const float density1 = static_cast<float>(junctionWeight(string1)) * string1.density;
+        const float density2 = static_cast<float>(junctionWeight(string2)) * string2.density;
+
+        for (int m = 0; m < numModes; m++) {
+            const float* phi1 = &shape1[m * N];
+            const float* phi2 = &shape2[m * N];
+            float py = 0.0f, pv = 0.0f;
+            for (int i = 0; i < N; i++) {
+                float w = (i == 0 || i == N - 1) ? 0.5f * dx : dx;
+                float w1 = w * density1 * phi1[i];
+                float w2 = w * density2 * phi2[i];
+                py += w1 * string1.y[i] + w2 * string2.y[i];
+                pv += w1 * string1.v[i] + w2 * string2.v[i];
+            }
+            float qm = py / modeMass[m];
+            float vm = pv / modeMass[m];
+            q[m] = qm;
+            qPrev[m] = backPos[m] * qm - backVel[m] * vm;
+        }
+
+        displacementDirty = true;
+        markEnergyDirty();
+    }
+
+    // Rebuilds the modes for new parameters, carrying the current motion over
+    void rebuildModes() {
+        updateDisplacement();
+        buildModes();
+        projectState();
+    }
+
+    // ========================================================================
+    // Grid reconstruction (lazy)
+    // ========================================================================
+    // Fills string1/2 y and v, the bridge and the bridge forces from the modes
+    void updateDisplacement() {
+        if (!displacementDirty) return;
+
+        const int N = NUM_POINTS;
+        float* __restrict y1 = string1.y.data();
+        float* __restrict v1 = string1.v.data();
+        float* __restrict y2 = string2.y.data();
+        float* __restrict v2 = string2.v.data();
+        std::fill(y1, y1 + N, 0.0f);
+        std::fill(v1, v1 + N, 0.0f);
+        std::fill(y2, y2 + N, 0.0f);
+        std::fill(v2, v2 + N, 0.0f);
+
+        for (int m = 0; m < numModes; m++) {
+            const float* __restrict phi1 = &shape1[m * N];
+            const float* __restrict phi2 = &shape2[m * N];
+            float qm = q[m];
+            float vm = velCur[m] * q[m] - velPrev[m] * qPrev[m];
+            for (int i = 0; i < N; i++) {
+                y1[i] += qm * phi1[i];
+                v1[i] += vm * phi1[i];
+                y2[i] += qm * phi2[i];
+                v2[i] += vm * phi2[i];
+            }
+        }
+
+        bridgeY = string1.y[N-1];
+        bridgeV = string1.v[N-1];
+
+        float dx = string1.length / (N - 1);
+        string1.forceOnBridge = -string1.tension * (string1.y[N-1] - string1.y[N-2]) / dx;
+        string2.forceOnBridge = -string2.tension * (string2.y[N-1] - string2.y[N-2]) / dx;
+
+        displacementDirty = false;
+    }
+
+    // ========================================================================
+    // Energy
+    // ========================================================================
+    void markEnergyDirty() {
+        energyDirty = true;
+        displacementDirty = true;
+        if (energyDiagnostics) updateEnergy();
+    }
+
+    void updateEnergy() {
+        if (!energyDirty) return;
+
+        updateDisplacement();
+        computeEnergy(string1);
+        computeEnergy(string2);
+        energyDirty = false;
+
+        maxTotalEnergy = std::max(maxTotalEnergy, string1.totalEnergy + string2.totalEnergy);
+    }
+
+    // Opt-in energy on every sample (reconstructs the grid each time)
+    void setEnergyDiagnostics(bool enabled) {
+        energyDiagnostics = enabled;
+        maxTotalEnergy = 0.0f;
+        updateEnergy();
+    }
+
+    void computeEnergy(StringState& s) {
+        float dx = s.length / (NUM_POINTS - 1);
+        float ke, pe;
+        kernels->energy(s.y.data(), s.v.data(), NUM_POINTS, s.density, s.tension, dx, ke, pe);
+
+        s.kineticEnergy = ke;
+        s.potentialEnergy = pe;
+        s.totalEnergy = ke + pe;
+    }
+
+    void recordHistory() {
+        updateEnergy();
+
+        energy1History.push(string1.totalEnergy);
+        energy2History.push(string2.totalEnergy);
+        bridgeHistory.push(bridgeY);
+    }
+
+    // Capacity in samples and decimation in steps (audio samples) per sample
+    void setHistoryConfig(int capacity, int interval) {
+        size_t cap = static_cast<size_t>(std::max(2, capacity));
+        energy1History.setCapacity(cap);
+        energy2History.setCapacity(cap);
+        bridgeHistory.setCapacity(cap);
+        historyInterval = std::max(1, interval);
+    }
+
+    // ========================================================================
+    // Setters
+    // ========================================================================
+    void setString1Frequency(float freq) {
+        string1.setFrequency(std::max(50.0f, std::min(1000.0f, freq)));
+        rebuildModes();
+    }
+
+    void setString2Frequency(float freq) {
+        string2.setFrequency(std::max(50.0f, std::min(1000.0f, freq)));
+        rebuildModes();
+    }
+
+    // Shapes are unchanged, so amplitudes and velocities carry over exactly
+    void setDamping(float d) {
+        float damping = std::max(0.0f, std::min(0.01f, d));
+
+        for (int m = 0; m < numModes; m++) modeVelocity[m] = velCur[m] * q[m] - velPrev[m] * qPrev[m];
+
+        string1.damping = damping;
+        string2.damping = damping;
+        for (int m = 0; m < numModes; m++) {
+            setModeDamping(m, 1.0, 0.0);  // Both strings share the rate
+            qPrev[m] = backPos[m] * q[m] - backVel[m] * modeVelocity[m];
+        }
+        markEnergyDirty();
+    }
+
+    void setBridgeStiffness(float s) {
+        bridgeStiffness = std::max(0.0f, std::min(1.0f, s));
+        rebuildModes();
+    }
+
+    // ========================================================================
+    // Getters
+    // ========================================================================
+    std::vector<float> getString1Displacement() {
+        updateDisplacement();
+        return std::vector<float>(string1.y.begin(), string1.y.end());
+    }
+
+    std::vector<float> getString2Displacement() {
+        updateDisplacement();
+        return std::vector<float>(string2.y.begin(), string2.y.end());
+    }
+
+    std::vector<float> getString1Velocity() {
+        updateDisplacement();
+        return std::vector<float>(string1.v.begin(), string1.v.end());
+    }
+
+    std::vector<float> getString2Velocity() {
+        updateDisplacement();
+        return std::vector<float>(string2.v.begin(), string2.v.end());
+    }
+
+    std::vector<float> getEnergy1History() { return energy1History.toVector(); }
+    std::vector<float> getEnergy2History() { return energy2History.toVector(); }
+    std::vector<float> getBridgeHistory() { return bridgeHistory.toVector(); }
+    int getHistoryCapacity() { return static_cast<int>(energy1History.capacity()); }
+    int getHistoryInterval() { return historyInterval; }
+
+    // Seconds simulated, from the step count (accumulating dt would stall)
+    float getTime() const {
+        return static_cast<float>(static_cast<double>(stepCount) / SAMPLE_RATE);
+    }
+    float getEnergy1() { updateEnergy(); return string1.totalEnergy; }
+    float getEnergy2() { updateEnergy(); return string2.totalEnergy; }
+    float getKinetic1() { updateEnergy(); return string1.kineticEnergy; }
+    float getKinetic2() { updateEnergy(); return string2.kineticEnergy; }
+    float getPotential1() { updateEnergy(); return string1.potentialEnergy; }
+    float getPotential2() { updateEnergy(); return string2.potentialEnergy; }
+    float getTotalEnergy() { updateEnergy(); return string1.totalEnergy + string2.totalEnergy; }
+    float getMaxTotalEnergy() { updateEnergy(); return maxTotalEnergy; }
+    bool getEnergyDiagnostics() { return energyDiagnostics; }
+    float getBridgeY() { updateDisplacement(); return bridgeY; }
+    float getBridgeV() { updateDisplacement(); return bridgeV; }
+    float getForce1() { updateDisplacement(); return string1.forceOnBridge; }
+    float getForce2() { updateDisplacement(); return string2.forceOnBridge; }
+    float getString1Frequency() { return string1.frequency; }
+    float getString2Frequency() { return string2.frequency; }
+    float getBridgeStiffness() { return bridgeStiffness; }
+    int getNumModes() { return numModes; }
+
+    float getModeFrequency(int mode) {
+        if (mode < 0 || mode >= numModes) return 0.0f;
+        return modeFrequency[mode];
+    }
+
+    void reset() {
+        string1 = StringState();
+        string2 = StringState();
+        string1.setFrequency(261.63f);
+        string2.setFrequency(392.00f);
+        bridgeY = 0.0f;
+        bridgeV = 0.0f;
+        bridgeStiffness = 1.0f;
+        stepCount = 0;
+        maxTotalEnergy = 0.0f;
+        energy1History.clear();
+        energy2History.clear();
+        bridgeHistory.clear();
+        buildModes();
+        updateEnergy();
+    }
+};
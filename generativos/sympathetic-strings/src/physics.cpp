@@ -1,409 +1,241 @@
 /**
- * Sympathetic Strings v3 - Rigid Bridge Model
+ * Sympathetic Strings - Emscripten bindings
  *
- * Physical Model: Two parallel strings sharing a RIGID bridge
- * ============================================================
- *
- *    Cejilla (fijo)                           Puente RÍGIDO
- *         |                                        |
- *         |========== Cuerda 1 (T1, μ1) ===========|
- *         |                                        |
- *         |========== Cuerda 2 (T2, μ2) ===========|
- *         |                                        |
- *       x=0                                      x=L
- *
- * Key Physics:
- * - The bridge is RIGID: it transmits vibration instantaneously
- * - Both strings share the same displacement at x=L
- * - Constraint: y1[end] = y2[end] = y_bridge
- *
- * How it works:
- * 1. Each string wants to move its right endpoint based on wave equation
- * 2. The rigid bridge FORCES both endpoints to be equal
- * 3. The bridge position is determined by force equilibrium
- * 4. Energy transfers through this shared constraint
- *
- * Bridge equilibrium (massless rigid bridge):
- *   T1 * (∂y1/∂x) + T2 * (∂y2/∂x) = 0  at bridge
- *   => y_bridge = weighted average based on string tensions
- *
- * This is how real sympathetic resonance works in pianos, sitars, etc.
+ * The engines live in physics.h, string_bank.h, modal_strings.h,
+ * waveguide_strings.h and pluck_cache.h and build natively without
+ * Emscripten; this file only exposes them to JavaScript. The pthreads build
+ * (physics-mt) also exposes PhysicsWorker (physics_worker.h).
  */
 
 #include <emscripten/bind.h>
-#include <cmath>
-#include <vector>
-#include <array>
-#include <algorithm>
+#include <emscripten/val.h>
+#include <emscripten/heap.h>
+#include <cstdint>
 
-constexpr int NUM_POINTS = 200;
-constexpr int HISTORY_LENGTH = 500;
-constexpr float PI = 3.14159265359f;
+#include "physics.h"
+#include "string_bank.h"
+#include "modal_strings.h"
+#include "waveguide_strings.h"
+#include "pluck_cache.h"
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include "physics_worker.h"
+#endif
 
 // ============================================================================
-// String State
+// Emscripten Bindings
 // ============================================================================
-struct StringState {
-    std::array<float, NUM_POINTS> y;
-    std::array<float, NUM_POINTS> y_prev;
-    std::array<float, NUM_POINTS> v;
-
-    float frequency;
-    float tension;
-    float density;
-    float damping;
-    float waveSpeed;
-    float length;  // Normalized length
-
-    float kineticEnergy;
-    float potentialEnergy;
-    float totalEnergy;
-
-    // Force exerted on bridge (computed each step)
-    float forceOnBridge;
-
-    StringState() {
-        y.fill(0.0f);
-        y_prev.fill(0.0f);
-        v.fill(0.0f);
-        frequency = 261.63f;
-        tension = 100.0f;
-        density = 0.001f;
-        damping = 0.00001f;  // Very low damping for sustained sound
-        length = 1.0f;
-        waveSpeed = std::sqrt(tension / density);
-        kineticEnergy = 0.0f;
-        potentialEnergy = 0.0f;
-        totalEnergy = 0.0f;
-        forceOnBridge = 0.0f;
-    }
 
-    void setFrequency(float freq) {
-        frequency = freq;
-        // f = c / (2L) => c = 2Lf, T = μc² = 4μL²f²
-        tension = 4.0f * density * length * length * freq * freq;
-        waveSpeed = std::sqrt(tension / density);
-    }
-};
+// Output buffers are heap offsets from Module._malloc (embind has no float*)
+template <typename Sim>
+static void renderBlockInto(Sim& sim, int numFrames, float pickupPos,
+                            uintptr_t outL, uintptr_t outR) {
+    sim.renderBlock(numFrames, pickupPos,
+                    reinterpret_cast<float*>(outL), reinterpret_cast<float*>(outR));
+}
 
-// ============================================================================
-// Sympathetic Strings Simulation with Movable Bridge
-// ============================================================================
-class SympatheticStrings {
-public:
-    StringState string1;
-    StringState string2;
-
-    // Rigid bridge state
-    float bridgeY;           // Bridge displacement (shared by both strings)
-    float bridgeV;           // Bridge velocity (for display only)
-    float bridgeStiffness;   // How rigidly strings couple (1.0 = perfect)
-
-    // Simulation
-    float dt;
-    float time;
-    int stepCount;
-
-    // History
-    std::vector<float> energy1History;
-    std::vector<float> energy2History;
-    std::vector<float> bridgeHistory;
-
-    SympatheticStrings() {
-        dt = 1.0f / (44100.0f * 8.0f);  // 8x oversampling for stability
-        time = 0.0f;
-        stepCount = 0;
-
-        bridgeY = 0.0f;
-        bridgeV = 0.0f;
-        bridgeStiffness = 1.0f;  // 1.0 = perfectly rigid coupling
-
-        // Default: C4 and G4 (perfect fifth, ratio 3:2)
-        string1.setFrequency(261.63f);
-        string2.setFrequency(392.00f);
-
-        energy1History.reserve(HISTORY_LENGTH);
-        energy2History.reserve(HISTORY_LENGTH);
-        bridgeHistory.reserve(HISTORY_LENGTH);
-    }
+// Snapshots go through heap buffers the same way (see SympatheticStrings::saveState)
+static size_t saveStateInto(SympatheticStrings& sim, uintptr_t out, size_t capacity) {
+    return sim.saveState(reinterpret_cast<uint8_t*>(out), capacity);
+}
 
-    // ========================================================================
-    // Pluck a string
-    // ========================================================================
-    void pluck(int stringIndex, float position, float amplitude) {
-        StringState& s = (stringIndex == 0) ? string1 : string2;
-
-        position = std::max(0.1f, std::min(0.9f, position));
-        amplitude = std::max(0.0f, std::min(1.0f, amplitude));
-
-        // Triangular initial shape
-        for (int i = 0; i < NUM_POINTS; i++) {
-            float x = static_cast<float>(i) / (NUM_POINTS - 1);
-
-            if (x < position) {
-                s.y[i] = amplitude * x / position;
-            } else {
-                s.y[i] = amplitude * (1.0f - x) / (1.0f - position);
-            }
-            s.y_prev[i] = s.y[i];
-            s.v[i] = 0.0f;
-        }
-
-        // Boundary: fixed end at 0
-        s.y[0] = 0.0f;
-        s.y_prev[0] = 0.0f;
-
-        // Bridge end will be set by bridge position
-        computeEnergy(s);
-    }
+static bool restoreStateFrom(SympatheticStrings& sim, uintptr_t data, size_t size) {
+    return sim.restoreState(reinterpret_cast<const uint8_t*>(data), size);
+}
 
-    // ========================================================================
-    // Physics Step
-    // ========================================================================
-    void step(int numSteps = 1) {
-        for (int n = 0; n < numSteps; n++) {
-            stepOnce();
-        }
-    }
+// ----------------------------------------------------------------------------
+// Zero-copy views
+// ----------------------------------------------------------------------------
+// Float32Array views straight over engine memory. Nothing is copied, but a
+// view is detached when wasm memory grows: JS caches views and refetches them
+// whenever getViewGeneration() changes. The generation also moves when a
+// retune changes a string's point count (and so the view length). History
+// views are [head, tail] pairs (oldest first, see history_ring.h) whose split
+// moves with every sample, so those are refetched every frame.
+//
+// ModalStrings and WaveguideStrings only fill their grids on request: every
+// string view getter refreshes them, and cached views need
+// updateDisplacement() before reading.
+
+static emscripten::val floatView(const float* data, size_t count) {
+    return emscripten::val(emscripten::typed_memory_view(count, data));
+}
 
-    void stepOnce() {
-        float dx = 1.0f / (NUM_POINTS - 1);
-        int N = NUM_POINTS;
-
-        // Courant numbers (with 8x oversampling, should be well under 1.0)
-        float r1 = string1.waveSpeed * dt / dx;
-        float r2 = string2.waveSpeed * dt / dx;
-        // No capping - 8x oversampling gives r < 0.3 for up to 500 Hz
-        float r1_sq = r1 * r1;
-        float r2_sq = r2 * r2;
-
-        std::array<float, NUM_POINTS> y1_new;
-        std::array<float, NUM_POINTS> y2_new;
-
-        // ================================================================
-        // Step 1: Update interior points with wave equation
-        // Both strings: fixed at left (x=0), will share bridge at right (x=L)
-        // ================================================================
-
-        // Fixed left boundary
-        y1_new[0] = 0.0f;
-        y2_new[0] = 0.0f;
-
-        // Interior points - standard wave equation
-        for (int i = 1; i < N - 1; i++) {
-            // String 1
-            float lap1 = string1.y[i+1] - 2.0f * string1.y[i] + string1.y[i-1];
-            float vel1 = (string1.y[i] - string1.y_prev[i]) / dt;
-            y1_new[i] = 2.0f * string1.y[i] - string1.y_prev[i]
-                       + r1_sq * lap1
-                       - string1.damping * dt * vel1;
-
-            // String 2
-            float lap2 = string2.y[i+1] - 2.0f * string2.y[i] + string2.y[i-1];
-            float vel2 = (string2.y[i] - string2.y_prev[i]) / dt;
-            y2_new[i] = 2.0f * string2.y[i] - string2.y_prev[i]
-                       + r2_sq * lap2
-                       - string2.damping * dt * vel2;
-        }
-
-        // ================================================================
-        // Step 2: Compute what each string "wants" at the bridge
-        // Using the wave equation extrapolated to the boundary
-        // ================================================================
-
-        // What string 1 would want at right end (based on neighbor)
-        float y1_want = 2.0f * string1.y[N-1] - string1.y_prev[N-1]
-                       + r1_sq * (string1.y[N-2] - 2.0f * string1.y[N-1] + string1.y[N-1])
-                       - string1.damping * dt * (string1.y[N-1] - string1.y_prev[N-1]) / dt;
-
-        // What string 2 would want at right end
-        float y2_want = 2.0f * string2.y[N-1] - string2.y_prev[N-1]
-                       + r2_sq * (string2.y[N-2] - 2.0f * string2.y[N-1] + string2.y[N-1])
-                       - string2.damping * dt * (string2.y[N-1] - string2.y_prev[N-1]) / dt;
-
-        // ================================================================
-        // Step 3: RIGID BRIDGE CONSTRAINT
-        // Both strings must have the same displacement at the bridge
-        // Position is weighted average based on tension (stiffness)
-        // ================================================================
-
-        float totalTension = string1.tension + string2.tension;
-        float newBridgeY = (string1.tension * y1_want + string2.tension * y2_want) / totalTension;
-
-        // Apply stiffness parameter (1.0 = perfectly rigid)
-        newBridgeY = bridgeStiffness * newBridgeY + (1.0f - bridgeStiffness) * bridgeY;
-
-        // Safety clamp
-        newBridgeY = std::max(-0.5f, std::min(0.5f, newBridgeY));
-        if (!std::isfinite(newBridgeY)) newBridgeY = 0.0f;
-
-        // Track velocity for display
-        bridgeV = (newBridgeY - bridgeY) / dt;
-        bridgeY = newBridgeY;
-
-        // ================================================================
-        // Step 4: Apply constraint - both strings share bridge position
-        // ================================================================
-        y1_new[N-1] = bridgeY;
-        y2_new[N-1] = bridgeY;
-
-        // Store forces for visualization
-        float slope1 = (y1_new[N-1] - y1_new[N-2]) / dx;
-        float slope2 = (y2_new[N-1] - y2_new[N-2]) / dx;
-        string1.forceOnBridge = -string1.tension * slope1;
-        string2.forceOnBridge = -string2.tension * slope2;
-
-        // ================================================================
-        // Step 5: Commit updates
-        // ================================================================
-        for (int i = 0; i < N; i++) {
-            string1.v[i] = (y1_new[i] - string1.y[i]) / dt;
-            string2.v[i] = (y2_new[i] - string2.y[i]) / dt;
-
-            string1.y_prev[i] = string1.y[i];
-            string1.y[i] = y1_new[i];
-
-            string2.y_prev[i] = string2.y[i];
-            string2.y[i] = y2_new[i];
-        }
-
-        // Compute energies
-        computeEnergy(string1);
-        computeEnergy(string2);
-
-        time += dt;
-        stepCount++;
-
-        // Record history
-        if (stepCount % 100 == 0) {
-            recordHistory();
-        }
-    }
+template <typename Sim>
+static uint32_t gridVersion(const Sim&) { return 0; }
+static uint32_t gridVersion(const SympatheticStrings& sim) { return sim.gridVersion; }
+static uint32_t gridVersion(const StringBank& bank) { return bank.gridVersion; }
+
+template <typename Sim>
+static uint32_t viewGeneration(Sim& sim) {
+    static size_t heapSize = 0;
+    static uint32_t generation = 0;
 
-    // ========================================================================
-    // Energy
-    // ========================================================================
-    void computeEnergy(StringState& s) {
-        float dx = 1.0f / (NUM_POINTS - 1);
-        float ke = 0.0f;
-        float pe = 0.0f;
-
-        for (int i = 0; i < NUM_POINTS; i++) {
-            ke += 0.5f * s.density * dx * s.v[i] * s.v[i];
-
-            if (i < NUM_POINTS - 1) {
-                float strain = (s.y[i+1] - s.y[i]) / dx;
-                pe += 0.5f * s.tension * strain * strain * dx;
-            }
-        }
-
-        s.kineticEnergy = ke;
-        s.potentialEnergy = pe;
-        s.totalEnergy = ke + pe;
+    size_t current = emscripten_get_heap_size();
+    if (current != heapSize) {
+        heapSize = current;
+        generation++;
     }
+    return generation + gridVersion(sim);
+}
 
-    void recordHistory() {
-        if (energy1History.size() >= HISTORY_LENGTH) {
-            energy1History.erase(energy1History.begin());
-            energy2History.erase(energy2History.begin());
-            bridgeHistory.erase(bridgeHistory.begin());
-        }
+#ifdef __EMSCRIPTEN_PTHREADS__
+static uint32_t gridVersion(const PhysicsWorker& worker) { return worker.displayVersion; }
+#endif
 
-        energy1History.push_back(string1.totalEnergy);
-        energy2History.push_back(string2.totalEnergy);
-        bridgeHistory.push_back(bridgeY);
-    }
+static void prepareViews(SympatheticStrings&) {}
+static void prepareViews(ModalStrings& sim) { sim.updateDisplacement(); }
+static void prepareViews(WaveguideStrings& sim) { sim.updateDisplacement(); }
 
-    // ========================================================================
-    // Setters
-    // ========================================================================
-    void setString1Frequency(float freq) {
-        string1.setFrequency(std::max(50.0f, std::min(1000.0f, freq)));
-    }
+template <typename Sim>
+static emscripten::val string1DisplacementView(Sim& sim) {
+    prepareViews(sim);
+    return floatView(sim.string1.y.data(), sim.string1.numPoints);
+}
 
-    void setString2Frequency(float freq) {
-        string2.setFrequency(std::max(50.0f, std::min(1000.0f, freq)));
-    }
+template <typename Sim>
+static emscripten::val string2DisplacementView(Sim& sim) {
+    prepareViews(sim);
+    return floatView(sim.string2.y.data(), sim.string2.numPoints);
+}
 
-    void setDamping(float d) {
-        float damping = std::max(0.0f, std::min(0.01f, d));
-        string1.damping = damping;
-        string2.damping = damping;
-    }
+template <typename Sim>
+static emscripten::val string1VelocityView(Sim& sim) {
+    prepareViews(sim);
+    return floatView(sim.string1.v.data(), sim.string1.numPoints);
+}
 
-    void setBridgeStiffness(float s) {
-        bridgeStiffness = std::max(0.0f, std::min(1.0f, s));
-    }
+template <typename Sim>
+static emscripten::val string2VelocityView(Sim& sim) {
+    prepareViews(sim);
+    return floatView(sim.string2.v.data(), sim.string2.numPoints);
+}
 
-    // ========================================================================
-    // Getters
-    // ========================================================================
-    std::vector<float> getString1Displacement() {
-        return std::vector<float>(string1.y.begin(), string1.y.end());
-    }
+static emscripten::val historyViews(const HistoryRing& ring) {
+    emscripten::val spans = emscripten::val::array();
+    spans.call<void>("push", floatView(ring.headData(), ring.headSize()));
+    spans.call<void>("push", floatView(ring.tailData(), ring.tailSize()));
+    return spans;
+}
 
-    std::vector<float> getString2Displacement() {
-        return std::vector<float>(string2.y.begin(), string2.y.end());
-    }
+template <typename Sim>
+static emscripten::val energy1HistoryView(Sim& sim) {
+    return historyViews(sim.energy1History);
+}
 
-    std::vector<float> getString1Velocity() {
-        return std::vector<float>(string1.v.begin(), string1.v.end());
-    }
+template <typename Sim>
+static emscripten::val energy2HistoryView(Sim& sim) {
+    return historyViews(sim.energy2History);
+}
 
-    std::vector<float> getString2Velocity() {
-        return std::vector<float>(string2.v.begin(), string2.v.end());
-    }
+template <typename Sim>
+static emscripten::val bridgeHistoryView(Sim& sim) {
+    return historyViews(sim.bridgeHistory);
+}
 
-    std::vector<float> getEnergy1History() { return energy1History; }
-    std::vector<float> getEnergy2History() { return energy2History; }
-    std::vector<float> getBridgeHistory() { return bridgeHistory; }
-
-    float getTime() { return time; }
-    float getEnergy1() { return string1.totalEnergy; }
-    float getEnergy2() { return string2.totalEnergy; }
-    float getKinetic1() { return string1.kineticEnergy; }
-    float getKinetic2() { return string2.kineticEnergy; }
-    float getPotential1() { return string1.potentialEnergy; }
-    float getPotential2() { return string2.potentialEnergy; }
-    float getTotalEnergy() { return string1.totalEnergy + string2.totalEnergy; }
-    float getBridgeY() { return bridgeY; }
-    float getBridgeV() { return bridgeV; }
-    float getForce1() { return string1.forceOnBridge; }
-    float getForce2() { return string2.forceOnBridge; }
-    float getString1Frequency() { return string1.frequency; }
-    float getString2Frequency() { return string2.frequency; }
-
-    void reset() {
-        string1 = StringState();
-        string2 = StringState();
-        string1.setFrequency(261.63f);
-        string2.setFrequency(392.00f);
-        bridgeY = 0.0f;
-        bridgeV = 0.0f;
-        bridgeStiffness = 1.0f;
-        time = 0.0f;
-        stepCount = 0;
-        energy1History.clear();
-        energy2History.clear();
-        bridgeHistory.clear();
-    }
+static emscripten::val bankDisplacementView(StringBank& bank, int stringIndex) {
+    if (stringIndex < 0 || stringIndex >= bank.numStrings) return emscripten::val::null();
+    return floatView(bank.row(stringIndex), bank.numPoints[stringIndex]);
+}
 
-    float getBridgeStiffness() { return bridgeStiffness; }
-};
+// ----------------------------------------------------------------------------
+// Physics worker (pthreads build)
+// ----------------------------------------------------------------------------
+// The UI reads the worker's latched PhysicsDisplay with the same getter
+// names as SympatheticStrings, so the page can use either. History views
+// keep the [head, tail] shape with an empty tail. The audio side reads the
+// ring straight from the shared heap with Atomics: getRing* return heap
+// byte offsets.
+#ifdef __EMSCRIPTEN_PTHREADS__
+
+static emscripten::val workerString1View(PhysicsWorker& w) {
+    return floatView(w.display().y1.data(), w.display().numPoints1);
+}
+
+static emscripten::val workerString2View(PhysicsWorker& w) {
+    return floatView(w.display().y2.data(), w.display().numPoints2);
+}
+
+static emscripten::val workerHistoryView(const PhysicsWorker& w, const float* data) {
+    emscripten::val spans = emscripten::val::array();
+    spans.call<void>("push", floatView(data, w.display().historySize));
+    spans.call<void>("push", floatView(data, 0));
+    return spans;
+}
+
+static emscripten::val workerEnergy1HistoryView(PhysicsWorker& w) {
+    return workerHistoryView(w, w.display().energy1History.data());
+}
+
+static emscripten::val workerEnergy2HistoryView(PhysicsWorker& w) {
+    return workerHistoryView(w, w.display().energy2History.data());
+}
+
+static emscripten::val workerBridgeHistoryView(PhysicsWorker& w) {
+    return workerHistoryView(w, w.display().bridgeHistory.data());
+}
+
+static float workerTime(PhysicsWorker& w) { return w.display().time; }
+static float workerEnergy1(PhysicsWorker& w) { return w.display().energy1; }
+static float workerEnergy2(PhysicsWorker& w) { return w.display().energy2; }
+static float workerTotalEnergy(PhysicsWorker& w) {
+    return w.display().energy1 + w.display().energy2;
+}
+static float workerBridgeY(PhysicsWorker& w) { return w.display().bridgeY; }
+static float workerForce1(PhysicsWorker& w) { return w.display().force1; }
+static float workerForce2(PhysicsWorker& w) { return w.display().force2; }
+
+static uintptr_t ringLeft(PhysicsWorker& w) {
+    return reinterpret_cast<uintptr_t>(w.audioRing().leftData());
+}
+static uintptr_t ringRight(PhysicsWorker& w) {
+    return reinterpret_cast<uintptr_t>(w.audioRing().rightData());
+}
+static uintptr_t ringWriteCounter(PhysicsWorker& w) {
+    return reinterpret_cast<uintptr_t>(w.audioRing().writeCounter());
+}
+static uintptr_t ringReadCounter(PhysicsWorker& w) {
+    return reinterpret_cast<uintptr_t>(w.audioRing().readCounter());
+}
+static uintptr_t ringFlushRequestCounter(PhysicsWorker& w) {
+    return reinterpret_cast<uintptr_t>(w.audioRing().flushRequestCounter());
+}
+static uintptr_t ringFlushDoneCounter(PhysicsWorker& w) {
+    return reinterpret_cast<uintptr_t>(w.audioRing().flushDoneCounter());
+}
+static int ringCapacity(PhysicsWorker&) { return WORKER_RING_FRAMES; }
+
+static float workerDspLoad(PhysicsWorker& w) { return w.loadMeter().load(); }
+static float workerWorstDspLoad(PhysicsWorker& w) { return w.loadMeter().worst(); }
+static float workerDspLoadPercentile(PhysicsWorker& w, float p) { return w.loadMeter().percentile(p); }
+static int workerOverruns(PhysicsWorker& w) { return static_cast<int>(w.loadMeter().overrunCount()); }
+static int workerTimedBlocks(PhysicsWorker& w) { return static_cast<int>(w.loadMeter().blockCount()); }
+static int workerLoadHistogram(PhysicsWorker& w, int bin) { return static_cast<int>(w.loadMeter().bin(bin)); }
+
+#endif
 
-// ============================================================================
-// Emscripten Bindings
-// ============================================================================
 EMSCRIPTEN_BINDINGS(sympathetic_strings) {
     emscripten::class_<SympatheticStrings>("SympatheticStrings")
         .constructor<>()
         .function("pluck", &SympatheticStrings::pluck)
         .function("step", &SympatheticStrings::step)
+        .function("renderBlock", &renderBlockInto<SympatheticStrings>)
         .function("reset", &SympatheticStrings::reset)
         .function("setString1Frequency", &SympatheticStrings::setString1Frequency)
         .function("setString2Frequency", &SympatheticStrings::setString2Frequency)
         .function("setDamping", &SympatheticStrings::setDamping)
         .function("setBridgeStiffness", &SympatheticStrings::setBridgeStiffness)
+        .function("schedulePluck", &SympatheticStrings::schedulePluck)
+        .function("scheduleString1Frequency", &SympatheticStrings::scheduleString1Frequency)
+        .function("scheduleString2Frequency", &SympatheticStrings::scheduleString2Frequency)
+        .function("scheduleDamping", &SympatheticStrings::scheduleDamping)
+        .function("scheduleBridgeStiffness", &SympatheticStrings::scheduleBridgeStiffness)
+        .function("clearEvents", &SympatheticStrings::clearEvents)
+        .function("getPendingEvents", &SympatheticStrings::getPendingEvents)
+        .function("getSnapshotSize", &SympatheticStrings::snapshotSize)
+        .function("saveState", &saveStateInto)
+        .function("restoreState", &restoreStateFrom)
+        .function("forkInto", &SympatheticStrings::forkInto)
         .function("getString1Displacement", &SympatheticStrings::getString1Displacement)
         .function("getString2Displacement", &SympatheticStrings::getString2Displacement)
         .function("getString1Velocity", &SympatheticStrings::getString1Velocity)
@@ -411,6 +243,17 @@ EMSCRIPTEN_BINDINGS(sympathetic_strings) {
         .function("getEnergy1History", &SympatheticStrings::getEnergy1History)
         .function("getEnergy2History", &SympatheticStrings::getEnergy2History)
         .function("getBridgeHistory", &SympatheticStrings::getBridgeHistory)
+        .function("setHistoryConfig", &SympatheticStrings::setHistoryConfig)
+        .function("getHistoryCapacity", &SympatheticStrings::getHistoryCapacity)
+        .function("getHistoryInterval", &SympatheticStrings::getHistoryInterval)
+        .function("getViewGeneration", &viewGeneration<SympatheticStrings>)
+        .function("getString1DisplacementView", &string1DisplacementView<SympatheticStrings>)
+        .function("getString2DisplacementView", &string2DisplacementView<SympatheticStrings>)
+        .function("getString1VelocityView", &string1VelocityView<SympatheticStrings>)
+        .function("getString2VelocityView", &string2VelocityView<SympatheticStrings>)
+        .function("getEnergy1HistoryView", &energy1HistoryView<SympatheticStrings>)
+        .function("getEnergy2HistoryView", &energy2HistoryView<SympatheticStrings>)
+        .function("getBridgeHistoryView", &bridgeHistoryView<SympatheticStrings>)
         .function("getTime", &SympatheticStrings::getTime)
         .function("getEnergy1", &SympatheticStrings::getEnergy1)
         .function("getEnergy2", &SympatheticStrings::getEnergy2)
@@ -419,13 +262,220 @@ EMSCRIPTEN_BINDINGS(sympathetic_strings) {
         .function("getPotential1", &SympatheticStrings::getPotential1)
         .function("getPotential2", &SympatheticStrings::getPotential2)
         .function("getTotalEnergy", &SympatheticStrings::getTotalEnergy)
+        .function("getMaxTotalEnergy", &SympatheticStrings::getMaxTotalEnergy)
+        .function("setEnergyDiagnostics", &SympatheticStrings::setEnergyDiagnostics)
+        .function("getEnergyDiagnostics", &SympatheticStrings::getEnergyDiagnostics)
+        .function("setImplicit", &SympatheticStrings::setImplicit)
+        .function("getImplicit", &SympatheticStrings::getImplicit)
+        .function("setImplicitSubsteps", &SympatheticStrings::setImplicitSubsteps)
+        .function("getImplicitSubsteps", &SympatheticStrings::getImplicitSubsteps)
         .function("getBridgeY", &SympatheticStrings::getBridgeY)
         .function("getBridgeV", &SympatheticStrings::getBridgeV)
         .function("getForce1", &SympatheticStrings::getForce1)
         .function("getForce2", &SympatheticStrings::getForce2)
         .function("getString1Frequency", &SympatheticStrings::getString1Frequency)
         .function("getString2Frequency", &SympatheticStrings::getString2Frequency)
+        .function("getString1NumPoints", &SympatheticStrings::getString1NumPoints)
+        .function("getString2NumPoints", &SympatheticStrings::getString2NumPoints)
+        .function("getString1Substeps", &SympatheticStrings::getString1Substeps)
+        .function("getString2Substeps", &SympatheticStrings::getString2Substeps)
+        .function("getString1Asleep", &SympatheticStrings::getString1Asleep)
+        .function("getString2Asleep", &SympatheticStrings::getString2Asleep)
+        .function("getDspLoad", &SympatheticStrings::getDspLoad)
+        .function("getWorstDspLoad", &SympatheticStrings::getWorstDspLoad)
+        .function("getDspLoadPercentile", &SympatheticStrings::getDspLoadPercentile)
+        .function("getOverruns", &SympatheticStrings::getOverruns)
+        .function("getTimedBlocks", &SympatheticStrings::getTimedBlocks)
+        .function("getLoadHistogram", &SympatheticStrings::getLoadHistogram)
+        .function("resetLoadStats", &SympatheticStrings::resetLoadStats)
+        .function("setLoadMetering", &SympatheticStrings::setLoadMetering)
         .function("getBridgeStiffness", &SympatheticStrings::getBridgeStiffness);
 
+    emscripten::class_<ModalStrings>("ModalStrings")
+        .constructor<>()
+        .function("pluck", &ModalStrings::pluck)
+        .function("step", &ModalStrings::step)
+        .function("renderBlock", &renderBlockInto<ModalStrings>)
+        .function("reset", &ModalStrings::reset)
+        .function("setString1Frequency", &ModalStrings::setString1Frequency)
+        .function("setString2Frequency", &ModalStrings::setString2Frequency)
+        .function("setDamping", &ModalStrings::setDamping)
+        .function("setBridgeStiffness", &ModalStrings::setBridgeStiffness)
+        .function("getString1Displacement", &ModalStrings::getString1Displacement)
+        .function("getString2Displacement", &ModalStrings::getString2Displacement)
+        .function("getString1Velocity", &ModalStrings::getString1Velocity)
+        .function("getString2Velocity", &ModalStrings::getString2Velocity)
+        .function("getEnergy1History", &ModalStrings::getEnergy1History)
+        .function("getEnergy2History", &ModalStrings::getEnergy2History)
+        .function("getBridgeHistory", &ModalStrings::getBridgeHistory)
+        .function("setHistoryConfig", &ModalStrings::setHistoryConfig)
+        .function("getHistoryCapacity", &ModalStrings::getHistoryCapacity)
+        .function("getHistoryInterval", &ModalStrings::getHistoryInterval)
+        .function("getViewGeneration", &viewGeneration<ModalStrings>)
+        .function("getString1DisplacementView", &string1DisplacementView<ModalStrings>)
+        .function("getString2DisplacementView", &string2DisplacementView<ModalStrings>)
+        .function("getString1VelocityView", &string1VelocityView<ModalStrings>)
+        .function("getString2VelocityView", &string2VelocityView<ModalStrings>)
+        .function("getEnergy1HistoryView", &energy1HistoryView<ModalStrings>)
+        .function("getEnergy2HistoryView", &energy2HistoryView<ModalStrings>)
+        .function("getBridgeHistoryView", &bridgeHistoryView<ModalStrings>)
+        .function("getTime", &ModalStrings::getTime)
+        .function("getEnergy1", &ModalStrings::getEnergy1)
+        .function("getEnergy2", &ModalStrings::getEnergy2)
+        .function("getKinetic1", &ModalStrings::getKinetic1)
+        .function("getKinetic2", &ModalStrings::getKinetic2)
+        .function("getPotential1", &ModalStrings::getPotential1)
+        .function("getPotential2", &ModalStrings::getPotential2)
+        .function("getTotalEnergy", &ModalStrings::getTotalEnergy)
+        .function("getMaxTotalEnergy", &ModalStrings::getMaxTotalEnergy)
+        .function("setEnergyDiagnostics", &ModalStrings::setEnergyDiagnostics)
+        .function("getEnergyDiagnostics", &ModalStrings::getEnergyDiagnostics)
+        .function("getBridgeY", &ModalStrings::getBridgeY)
+        .function("getBridgeV", &ModalStrings::getBridgeV)
+        .function("getForce1", &ModalStrings::getForce1)
+        .function("getForce2", &ModalStrings::getForce2)
+        .function("getString1Frequency", &ModalStrings::getString1Frequency)
+        .function("getString2Frequency", &ModalStrings::getString2Frequency)
+        .function("getBridgeStiffness", &ModalStrings::getBridgeStiffness)
+        .function("updateDisplacement", &ModalStrings::updateDisplacement)
+        .function("getNumModes", &ModalStrings::getNumModes)
+        .function("getModeFrequency", &ModalStrings::getModeFrequency);
+
+    emscripten::class_<WaveguideStrings>("WaveguideStrings")
+        .constructor<>()
+        .function("pluck", &WaveguideStrings::pluck)
+        .function("step", &WaveguideStrings::step)
+        .function("renderBlock", &renderBlockInto<WaveguideStrings>)
+        .function("reset", &WaveguideStrings::reset)
+        .function("setString1Frequency", &WaveguideStrings::setString1Frequency)
+        .function("setString2Frequency", &WaveguideStrings::setString2Frequency)
+        .function("setDamping", &WaveguideStrings::setDamping)
+        .function("setBridgeStiffness", &WaveguideStrings::setBridgeStiffness)
+        .function("getString1Displacement", &WaveguideStrings::getString1Displacement)
+        .function("getString2Displacement", &WaveguideStrings::getString2Displacement)
+        .function("getString1Velocity", &WaveguideStrings::getString1Velocity)
+        .function("getString2Velocity", &WaveguideStrings::getString2Velocity)
+        .function("getEnergy1History", &WaveguideStrings::getEnergy1History)
+        .function("getEnergy2History", &WaveguideStrings::getEnergy2History)
+        .function("getBridgeHistory", &WaveguideStrings::getBridgeHistory)
+        .function("setHistoryConfig", &WaveguideStrings::setHistoryConfig)
+        .function("getHistoryCapacity", &WaveguideStrings::getHistoryCapacity)
+        .function("getHistoryInterval", &WaveguideStrings::getHistoryInterval)
+        .function("getViewGeneration", &viewGeneration<WaveguideStrings>)
+        .function("getString1DisplacementView", &string1DisplacementView<WaveguideStrings>)
+        .function("getString2DisplacementView", &string2DisplacementView<WaveguideStrings>)
+        .function("getString1VelocityView", &string1VelocityView<WaveguideStrings>)
+        .function("getString2VelocityView", &string2VelocityView<WaveguideStrings>)
+        .function("getEnergy1HistoryView", &energy1HistoryView<WaveguideStrings>)
+        .function("getEnergy2HistoryView", &energy2HistoryView<WaveguideStrings>)
+        .function("getBridgeHistoryView", &bridgeHistoryView<WaveguideStrings>)
+        .function("getTime", &WaveguideStrings::getTime)
+        .function("getEnergy1", &WaveguideStrings::getEnergy1)
+        .function("getEnergy2", &WaveguideStrings::getEnergy2)
+        .function("getKinetic1", &WaveguideStrings::getKinetic1)
+        .function("getKinetic2", &WaveguideStrings::getKinetic2)
+        .function("getPotential1", &WaveguideStrings::getPotential1)
+        .function("getPotential2", &WaveguideStrings::getPotential2)
+        .function("getTotalEnergy", &WaveguideStrings::getTotalEnergy)
+        .function("getMaxTotalEnergy", &WaveguideStrings::getMaxTotalEnergy)
+        .function("setEnergyDiagnostics", &WaveguideStrings::setEnergyDiagnostics)
+        .function("getEnergyDiagnostics", &WaveguideStrings::getEnergyDiagnostics)
+        .function("getBridgeY", &WaveguideStrings::getBridgeY)
+        .function("getBridgeV", &WaveguideStrings::getBridgeV)
+        .function("getForce1", &WaveguideStrings::getForce1)
+        .function("getForce2", &WaveguideStrings::getForce2)
+        .function("getString1Frequency", &WaveguideStrings::getString1Frequency)
+        .function("getString2Frequency", &WaveguideStrings::getString2Frequency)
+        .function("getBridgeStiffness", &WaveguideStrings::getBridgeStiffness)
+        .function("updateDisplacement", &WaveguideStrings::updateDisplacement);
+
+    emscripten::class_<StringBank>("StringBank")
+        .constructor<int>()
+        .function("pluck", &StringBank::pluck)
+        .function("step", &StringBank::step)
+        .function("renderBlock", &renderBlockInto<StringBank>)
+        .function("reset", &StringBank::reset)
+        .function("setFrequency", &StringBank::setFrequency)
+        .function("setDamping", &StringBank::setDamping)
+        .function("setStringDamping", &StringBank::setStringDamping)
+        .function("setBridgeStiffness", &StringBank::setBridgeStiffness)
+        .function("getDisplacement", &StringBank::getDisplacement)
+        .function("getViewGeneration", &viewGeneration<StringBank>)
+        .function("getDisplacementView", &bankDisplacementView)
+        .function("getEnergy", &StringBank::getEnergy)
+        .function("getTotalEnergy", &StringBank::getTotalEnergy)
+        .function("getNumStrings", &StringBank::getNumStrings)
+        .function("getNumPoints", &StringBank::getNumPoints)
+        .function("getFrequency", &StringBank::getFrequency)
+        .function("getTime", &StringBank::getTime)
+        .function("getBridgeY", &StringBank::getBridgeY)
+        .function("getBridgeV", &StringBank::getBridgeV)
+        .function("getBridgeStiffness", &StringBank::getBridgeStiffness);
+
+    // Responses are recorded by computePending, called from JS between audio
+    // callbacks (requestIdleCallback) with a frame budget
+    emscripten::class_<PluckCache>("PluckCache")
+        .constructor<>()
+        .function("pluck", &PluckCache::pluck)
+        .function("prepare", &PluckCache::prepare)
+        .function("renderBlock", &renderBlockInto<PluckCache>)
+        .function("reset", &PluckCache::reset)
+        .function("computePending", &PluckCache::computePending)
+        .function("setString1Frequency", &PluckCache::setString1Frequency)
+        .function("setString2Frequency", &PluckCache::setString2Frequency)
+        .function("setDamping", &PluckCache::setDamping)
+        .function("setBridgeStiffness", &PluckCache::setBridgeStiffness)
+        .function("setImplicit", &PluckCache::setImplicit)
+        .function("isCached", &PluckCache::isCached)
+        .function("getCachedCount", &PluckCache::getCachedCount)
+        .function("getActiveVoices", &PluckCache::getActiveVoices);
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+    emscripten::class_<PhysicsWorker>("PhysicsWorker")
+        .constructor<>()
+        .function("pluck", &PhysicsWorker::pluck)
+        .function("step", &PhysicsWorker::step)
+        .function("reset", &PhysicsWorker::reset)
+        .function("setString1Frequency", &PhysicsWorker::setString1Frequency)
+        .function("setString2Frequency", &PhysicsWorker::setString2Frequency)
+        .function("setDamping", &PhysicsWorker::setDamping)
+        .function("setBridgeStiffness", &PhysicsWorker::setBridgeStiffness)
+        .function("setImplicit", &PhysicsWorker::setImplicit)
+        .function("setPickup", &PhysicsWorker::setPickup)
+        .function("setStreaming", &PhysicsWorker::setStreaming)
+        .function("setWatermarks", &PhysicsWorker::setWatermarks)
+        .function("getUnderruns", &PhysicsWorker::getUnderruns)
+        .function("getDspLoad", &workerDspLoad)
+        .function("getWorstDspLoad", &workerWorstDspLoad)
+        .function("getDspLoadPercentile", &workerDspLoadPercentile)
+        .function("getOverruns", &workerOverruns)
+        .function("getTimedBlocks", &workerTimedBlocks)
+        .function("getLoadHistogram", &workerLoadHistogram)
+        .function("resetLoadStats", &PhysicsWorker::resetLoadStats)
+        .function("latchDisplay", &PhysicsWorker::latchDisplay)
+        .function("getViewGeneration", &viewGeneration<PhysicsWorker>)
+        .function("getString1DisplacementView", &workerString1View)
+        .function("getString2DisplacementView", &workerString2View)
+        .function("getEnergy1HistoryView", &workerEnergy1HistoryView)
+        .function("getEnergy2HistoryView", &workerEnergy2HistoryView)
+        .function("getBridgeHistoryView", &workerBridgeHistoryView)
+        .function("getTime", &workerTime)
+        .function("getEnergy1", &workerEnergy1)
+        .function("getEnergy2", &workerEnergy2)
+        .function("getTotalEnergy", &workerTotalEnergy)
+        .function("getBridgeY", &workerBridgeY)
+        .function("getForce1", &workerForce1)
+        .function("getForce2", &workerForce2)
+        .function("getString1Frequency", &PhysicsWorker::getString1Frequency)
+        .function("getString2Frequency", &PhysicsWorker::getString2Frequency)
+        .function("getRingLeft", &ringLeft)
+        .function("getRingRight", &ringRight)
+        .function("getRingWriteCounter", &ringWriteCounter)
+        .function("getRingReadCounter", &ringReadCounter)
+        .function("getRingFlushRequestCounter", &ringFlushRequestCounter)
+        .function("getRingFlushDoneCounter", &ringFlushDoneCounter)
+        .function("getRingCapacity", &ringCapacity);
+#endif
+
     emscripten::register_vector<float>("VectorFloat");
 }
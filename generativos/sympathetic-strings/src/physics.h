@@ -0,0 +1,1206 @@
+/**
+ * Sympathetic Strings v3 - Rigid Bridge Model
+ *
+ * Physical Model: Two parallel strings sharing a RIGID bridge
+ * ============================================================
+ *
+ *    Cejilla (fijo)                           Puente RÍGIDO
+ *         |                                        |
+ *         |========== Cuerda 1 (T1, μ1) ===========|
+ *         |                                        |
+ *         |========== Cuerda 2 (T2, μ2) ===========|
+ *         |                                        |
+ *       x=0                                      x=L
+ *
+ * Key Physics:
+ * - The bridge is RIGID: it transmits vibration instantaneously
+ * - Both strings share the same displacement at x=L
+ * - Constraint: y1[end] = y2[end] = y_bridge
+ *
+ * How it works:
+ * 1. Each string wants to move its right endpoint based on wave equation
+ * 2. The rigid bridge FORCES both endpoints to be equal
+ * 3. The bridge position is determined by force equilibrium
+ * 4. Energy transfers through this shared constraint
+ *
+ * Bridge equilibrium (massless rigid bridge):
+ *   T1 * (∂y1/∂x) + T2 * (∂y2/∂x) = 0  at bridge
+ *   => y_bridge = weighted average based on string tensions
+ *
+ * This is how real sympathetic resonance works in pianos, sitars, etc.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+#include "stencil_kernels.h"
+#include "temporal_blocking.h"
+#include "history_ring.h"
+#include "tridiagonal.h"
+#include "../../sympathetic-common/denormals.h"
+#include "../../sympathetic-common/event_queue.h"
+#include "../../sympathetic-common/snapshot.h"
+#include "../../sympathetic-common/load_meter.h"
+
+constexpr int NUM_POINTS = 200;          // Grid capacity per string
+constexpr int MIN_POINTS = 16;           // Coarsest grid a string may get
+constexpr float COURANT_TARGET = 0.95f;  // Courant number each grid aims for
+constexpr int HISTORY_LENGTH = 500;      // Default history capacity
+constexpr int HISTORY_INTERVAL = 100;    // Default steps between history samples
+constexpr float PI = 3.14159265359f;
+constexpr float SAMPLE_RATE = 44100.0f;
+constexpr int OVERSAMPLING = 8;          // Physics substeps per audio sample
+constexpr float PICKUP_GAIN = 3.0f;      // Displacement -> audio level
+constexpr float STEREO_MIX = 0.7f;       // Own-side share of each string
+constexpr float IMPLICIT_THETA = 0.25f;  // θ of the implicit scheme (>= 1/4: stable)
+constexpr int IMPLICIT_SUBSTEPS = 2;     // Default implicit steps per audio sample
+constexpr float SLEEP_ENERGY = 1e-10f;   // Energy / tension under which a string sleeps
+constexpr float SLEEP_BRIDGE = 1e-6f;    // Bridge displacement that keeps strings awake
+constexpr int SLEEP_INTERVAL = 64 * OVERSAMPLING;  // Base steps between sleep checks
+constexpr uint32_t STRINGS_SNAPSHOT_VERSION = 2;  // 2: 64-bit step count, no stored time
+constexpr int MAX_SNAPSHOT_HISTORY = 1 << 24;      // Largest history a snapshot may restore
+
+// ============================================================================
+// Grid Resolution
+// ============================================================================
+// Leapfrog is stable for Courant numbers r = c*dt/dx <= 1 and least
+// dispersive close to 1. Each string first gets the fewest substeps per audio
+// sample (1, 2, 4 .. OVERSAMPLING) that keep a full NUM_POINTS grid under
+// COURANT_TARGET, then the grid that puts r just under it at that substep:
+// n - 1 = floor(COURANT_TARGET * L / (c*dt)) intervals. Low strings run few
+// substeps on a full grid; strings too high for OVERSAMPLING substeps keep
+// the full rate and get a coarser grid instead.
+inline int courantSubsteps(float waveSpeed, float length, int maxPoints = NUM_POINTS) {
+    float needed = waveSpeed * (maxPoints - 1) / (length * SAMPLE_RATE * COURANT_TARGET);
+    int substeps = 1;
+    while (substeps < OVERSAMPLING && substeps < needed) substeps *= 2;
+    return substeps;
+}
+
+inline int courantPoints(float waveSpeed, float length, float dt, int maxPoints = NUM_POINTS) {
+    float intervals = std::floor(COURANT_TARGET * length / (waveSpeed * dt));
+    return std::max(MIN_POINTS, std::min(maxPoints, static_cast<int>(intervals) + 1));
+}
+
+// Linearly resamples y[0..oldN) onto newN points in place, keeping both ends
+// (oldN <= Capacity)
+template <int Capacity = NUM_POINTS, typename Real>
+inline void resampleGrid(Real* y, int oldN, int newN) {
+    if (oldN == newN) return;
+    std::array<Real, Capacity> src;
+    std::copy(y, y + oldN, src.begin());
+    for (int i = 0; i < newN; i++) {
+        Real pos = static_cast<Real>(i) * (oldN - 1) / (newN - 1);
+        int j = std::min(static_cast<int>(pos), oldN - 2);
+        Real frac = pos - j;
+        y[i] = src[j] + frac * (src[j+1] - src[j]);
+    }
+}
+
+// ============================================================================
+// String State
+// ============================================================================
+// The arrays hold Points, of which the first numPoints are in use.
+template <typename Real, int Points>
+struct BasicStringState {
+    std::array<Real, Points> y;
+    std::array<Real, Points> y_prev;
+    std::array<Real, Points> v;
+    std::array<Real, Points> y_next;  // Third time level for stepFused
+
+    Real frequency;
+    Real tension;
+    Real density;
+    Real damping;
+    Real waveSpeed;
+    Real length;  // Normalized length
+    int numPoints; // Active grid points, bridge at numPoints - 1
+
+    // Multi-rate stepping (see SympatheticStrings::stepOnce)
+    int stride;     // Base steps per substep: OVERSAMPLING / substeps per sample
+    bool inFlight;  // Substep started: interior in y_next, bridge end pending
+    bool asleep;    // Silent: zeroed and skipped (see SympatheticStrings::updateSleep)
+
+    Real kineticEnergy;
+    Real potentialEnergy;
+    Real totalEnergy;
+
+    // Force exerted on bridge (computed each step)
+    Real forceOnBridge;
+
+    BasicStringState() {
+        y.fill(0.0f);
+        y_prev.fill(0.0f);
+        v.fill(0.0f);
+        y_next.fill(0.0f);
+        frequency = 261.63f;
+        tension = 100.0f;
+        density = 0.001f;
+        damping = 0.00001f;  // Very low damping for sustained sound
+        length = 1.0f;
+        waveSpeed = std::sqrt(tension / density);
+        numPoints = Points;
+        stride = 1;
+        inFlight = false;
+        asleep = false;
+        kineticEnergy = 0.0f;
+        potentialEnergy = 0.0f;
+        totalEnergy = 0.0f;
+        forceOnBridge = 0.0f;
+    }
+
+    void setFrequency(Real freq) {
+        frequency = freq;
+        // f = c / (2L) => c = 2Lf, T = μc² = 4μL²f²
+        tension = 4.0f * density * length * length * freq * freq;
+        waveSpeed = std::sqrt(tension / density);
+    }
+
+    // Moves the current shape onto an n-point grid
+    void setNumPoints(int n) {
+        resampleGrid<Points>(y.data(), numPoints, n);
+        resampleGrid<Points>(y_prev.data(), numPoints, n);
+        resampleGrid<Points>(v.data(), numPoints, n);
+        numPoints = n;
+    }
+
+    Real dx() const { return length / (numPoints - 1); }
+};
+
+using StringState = BasicStringState<float, NUM_POINTS>;
+
+// ============================================================================
+// Implicit θ-scheme
+// ============================================================================
+// Alternative to the explicit leapfrog (SympatheticStrings::setImplicit).
+// Per step, with λ = r², d the per-step damping and L the second difference:
+//
+//   (1 + d/2) y+ - λθ L y+  =  2y - (1 - d/2) y- + λ(1 - 2θ) L y + λθ L y-
+//
+// θ >= 1/4 is stable for any λ, so the step no longer has to resolve the
+// Courant limit; θ = 1/4 is the trapezoidal (Crank-Nicolson) rule. The
+// interior points form the system of tridiagonal.h with a = 1 + d/2 + 2λθ
+// and b = λθ, factored once per parameter change.
+template <typename Real, int Points>
+struct BasicThetaSystem {
+    std::array<Real, Points> inv;   // Pivot reciprocals
+    std::array<Real, Points> mult;  // Multipliers b * inv
+    std::array<Real, Points> pair;  // Neighbouring multiplier products
+    Real lambda = -1.0f;            // λ, d and n the factors were built for
+    Real damping = -1.0f;
+    int numPoints = 0;
+
+    void prepare(Real lambdaNow, Real dampingNow, int n) {
+        if (lambdaNow == lambda && dampingNow == damping && n == numPoints) return;
+        lambda = lambdaNow;
+        damping = dampingNow;
+        numPoints = n;
+        Real b = lambda * IMPLICIT_THETA;
+        factorTridiagonal(1.0f + 0.5f * damping + 2.0f * b, b, n - 2,
+                          inv.data(), mult.data(), pair.data());
+    }
+};
+
+// Right-hand side of the interior equations of one string into
+// out[1..n-2] (out[i] is the equation of point i)
+template <typename Real>
+inline void thetaRhs(const Real* __restrict y, const Real* __restrict yPrev,
+                     Real* __restrict out, int n, Real lambda, Real damping) {
+    Real keep = 1.0f - 0.5f * damping;
+    Real explicitPart = lambda * (1.0f - 2.0f * IMPLICIT_THETA);
+    Real implicitPart = lambda * IMPLICIT_THETA;
+    for (int i = 1; i < n - 1; i++) {
+        Real lap = y[i+1] - 2.0f * y[i] + y[i-1];
+        Real lapPrev = yPrev[i+1] - 2.0f * yPrev[i] + yPrev[i-1];
+        out[i] = 2.0f * y[i] - keep * yPrev[i] + explicitPart * lap + implicitPart * lapPrev;
+    }
+}
+
+// ============================================================================
+// Sympathetic Strings Simulation with Movable Bridge
+// ============================================================================
+// Real is the scalar type of the whole simulation and Points the grid
+// capacity of each string, so every array has a compile-time extent.
+// SympatheticStrings (below) is the float / NUM_POINTS engine of the web
+// build; strings_factory.h picks other instantiations at runtime.
+template <typename Real, int Points>
+class BasicSympatheticStrings {
+public:
+    using StringState = BasicStringState<Real, Points>;
+    using ThetaSystem = BasicThetaSystem<Real, Points>;
+
+    StringState string1;
+    StringState string2;
+
+    // Rigid bridge state
+    Real bridgeY;            // Bridge displacement (shared by both strings)
+    Real bridgePrevY;        // Bridge displacement one bridge step ago
+    Real bridgeV;            // Bridge velocity (for display only)
+    Real bridgeStiffness;    // How rigidly strings couple (1.0 = perfect)
+
+    // Simulation
+    Real dt;
+    int64_t stepCount;       // Base steps of dt (OVERSAMPLING per audio sample); the clock
+    int gridVersion = 0;     // Bumped whenever a string's point count changes
+
+    // History (fixed-capacity rings, one sample every historyInterval steps)
+    HistoryRing energy1History{HISTORY_LENGTH};
+    HistoryRing energy2History{HISTORY_LENGTH};
+    HistoryRing bridgeHistory{HISTORY_LENGTH};
+    int historyInterval = HISTORY_INTERVAL;
+
+    // Inner loops (scalar / SIMD128 / AVX2 / AVX-512)
+    const BasicStencilKernels<Real>* kernels = &stencilKernelsFor<Real>();
+
+    // Implicit θ-scheme instead of the explicit leapfrog (setImplicit)
+    bool implicitScheme = false;
+    int implicitSubsteps = IMPLICIT_SUBSTEPS;
+    ThetaSystem theta1;
+    ThetaSystem theta2;
+
+    // Energy is computed lazily: stepping only marks it dirty, and the getters
+    // and history recorder compute it when they need it. Diagnostics mode
+    // computes it on every substep instead and tracks the peak total.
+    bool energyDirty = false;
+    bool energyDiagnostics = false;
+    Real maxTotalEnergy = 0.0f;
+
+    // Plucks and parameter changes scheduled inside upcoming blocks
+    // (see Scheduled Events)
+    EventQueue<> events;
+
+    // Time of every renderBlock against its real-time budget (see DSP Load)
+    LoadMeter loadMeter;
+
+    BasicSympatheticStrings() {
+        dt = 1.0f / (static_cast<Real>(SAMPLE_RATE) * OVERSAMPLING);  // 8x oversampling for stability
+        stepCount = 0;
+
+        bridgeY = 0.0f;
+        bridgePrevY = 0.0f;
+        bridgeV = 0.0f;
+        bridgeStiffness = 1.0f;  // 1.0 = perfectly rigid coupling
+
+        // Default: C4 and G4 (perfect fifth, ratio 3:2)
+        string1.setFrequency(261.63f);
+        string2.setFrequency(392.00f);
+        fitGrid(string1);
+        fitGrid(string2);
+    }
+
+    // Implicit steps per audio sample, rounded down to a power of two up to
+    // OVERSAMPLING. One step per sample is the cheapest setting but flattens
+    // the upper partials of high strings by several cents.
+    void setImplicitSubsteps(int substeps) {
+        int k = 1;
+        while (k * 2 <= std::min(substeps, OVERSAMPLING)) k *= 2;
+        implicitSubsteps = k;
+        fitGrid(string1);
+        fitGrid(string2);
+    }
+
+    // ========================================================================
+    // Pluck a string
+    // ========================================================================
+    void pluck(int stringIndex, Real position, Real amplitude) {
+        StringState& s = (stringIndex == 0) ? string1 : string2;
+
+        position = std::max<Real>(0.1f, std::min<Real>(0.9f, position));
+        amplitude = std::max<Real>(0.0f, std::min<Real>(1.0f, amplitude));
+
+        // Triangular initial shape
+        const int N = s.numPoints;
+        for (int i = 0; i < N; i++) {
+            Real x = static_cast<Real>(i) / (N - 1);
+
+            if (x < position) {
+                s.y[i] = amplitude * x / position;
+            } else {
+                s.y[i] = amplitude * (1.0f - x) / (1.0f - position);
+            }
+            s.y_prev[i] = s.y[i];
+            s.v[i] = 0.0f;
+        }
+
+        // Boundary: fixed end at 0
+        s.y[0] = 0.0f;
+        s.y_prev[0] = 0.0f;
+
+        // A substep in flight was computed from the old shape
+        s.inFlight = false;
+        s.asleep = false;
+        wakeString(&s == &string1 ? string2 : string1, false);
+
+        // Bridge end will be set by bridge position
+        markEnergyDirty();
+    }
+
+    // ========================================================================
+    // Physics Step
+    // ========================================================================
+    void step(int numSteps = 1) {
+        DenormalGuard guard;
+        for (int n = 0; n < numSteps; n++) {
+            stepOnce();
+        }
+    }
+
+    // ========================================================================
+    // Scheduled Events
+    // ========================================================================
+    // Same as the setters, applied right before sample `offset` of the next
+    // renderBlock (or a later one: offsets past the block carry over, see
+    // event_queue.h). Returns false when the queue is full. step() does
+    // not apply events, it has no samples.
+    enum EventType { PLUCK_EVENT, FREQUENCY_EVENT, DAMPING_EVENT, STIFFNESS_EVENT };
+
+    bool schedulePluck(int offset, int stringIndex, Real position, Real amplitude) {
+        return events.push({offset, PLUCK_EVENT, stringIndex, static_cast<float>(position),
+                            static_cast<float>(amplitude)});
+    }
+    bool scheduleString1Frequency(int offset, Real freq) {
+        return events.push({offset, FREQUENCY_EVENT, 0, static_cast<float>(freq), 0.0f});
+    }
+    bool scheduleString2Frequency(int offset, Real freq) {
+        return events.push({offset, FREQUENCY_EVENT, 1, static_cast<float>(freq), 0.0f});
+    }
+    bool scheduleDamping(int offset, Real d) {
+        return events.push({offset, DAMPING_EVENT, 0, static_cast<float>(d), 0.0f});
+    }
+    bool scheduleBridgeStiffness(int offset, Real s) {
+        return events.push({offset, STIFFNESS_EVENT, 0, static_cast<float>(s), 0.0f});
+    }
+
+    void clearEvents() { events.clear(); }
+    int getPendingEvents() { return events.size(); }
+
+    // ========================================================================
+    // Block Rendering
+    // ========================================================================
+    // Runs OVERSAMPLING base steps per frame (each string at its own substep
+    // rate) and reads both strings at the pickup, writing stereo straight
+    // into outL/outR (numFrames floats each). String 1 leans left, string 2
+    // leans right. Scheduled events split the block into spans and apply at
+    // their sample.
+    void renderBlock(int numFrames, Real pickupPos, float* outL, float* outR) {
+        LoadMeter::Scope timing(loadMeter, numFrames, SAMPLE_RATE);
+        DenormalGuard guard;
+
+        pickupPos = std::max<Real>(0.0f, std::min<Real>(1.0f, pickupPos));
+        int done = 0;
+        while (done < numFrames) {
+            TimedEvent event;
+            while (events.popDue(done, event)) applyEvent(event);
+
+            int end = events.empty() ? numFrames : std::min(numFrames, events.nextOffset());
+            renderSpan(end - done, pickupPos, outL + done, outR + done);
+            done = end;
+        }
+        events.advance(numFrames);
+    }
+
+    void applyEvent(const TimedEvent& e) {
+        switch (e.type) {
+            case PLUCK_EVENT: pluck(e.index, e.a, e.b); break;
+            case FREQUENCY_EVENT:
+                if (e.index == 0) setString1Frequency(e.a);
+                else setString2Frequency(e.a);
+                break;
+            case DAMPING_EVENT: setDamping(e.a); break;
+            case STIFFNESS_EVENT: setBridgeStiffness(e.a); break;
+        }
+    }
+
+    // numFrames frames with no event inside
+    void renderSpan(int numFrames, Real pickupPos, float* outL, float* outR) {
+        // Nothing can wake a silent instance mid-span
+        if (allAsleep()) {
+            std::fill(outL, outL + numFrames, 0.0f);
+            std::fill(outR, outR + numFrames, 0.0f);
+            advanceClock(numFrames * OVERSAMPLING);
+            return;
+        }
+
+        int pickup1 = pickupIndex(string1, pickupPos);
+        int pickup2 = pickupIndex(string2, pickupPos);
+
+        for (int i = 0; i < numFrames; i++) {
+            stepFused(OVERSAMPLING);
+
+            Real s1 = string1.y[pickup1] * PICKUP_GAIN;
+            Real s2 = string2.y[pickup2] * PICKUP_GAIN;
+
+            outL[i] = s1 * STEREO_MIX + s2 * (1.0f - STEREO_MIX);
+            outR[i] = s1 * (1.0f - STEREO_MIX) + s2 * STEREO_MIX;
+        }
+    }
+
+    // Grid point nearest pickupPos (0..1) on a string
+    static int pickupIndex(const StringState& s, Real pickupPos) {
+        return std::min(s.numPoints - 1, static_cast<int>(pickupPos * s.numPoints));
+    }
+
+    // ========================================================================
+    // Multi-rate Substeps
+    // ========================================================================
+    // stepOnce() advances the base clock by dt = 1 / (SAMPLE_RATE *
+    // OVERSAMPLING). Each string takes one substep every `stride` base steps
+    // (stride = OVERSAMPLING / its substeps per sample, see courantSubsteps):
+    //
+    //   time (base steps)  0  1  2  3  4  5  6  7  8
+    //   string 1           |-----------|-----------|   (stride 4)
+    //   string 2           |-----|-----|-----|-----|   (stride 2)
+    //   bridge solved            *     *     *     *   (fastest stride)
+    //
+    // At the start of its substep a string updates its interior into y_next.
+    // The bridge steps at the fastest stride: each string's "want" is the
+    // bridge's own leapfrog step plus the pull of the string's last interior
+    // point, which for a slower string is interpolated between its two
+    // levels. When its substep ends, the string takes the bridge value and
+    // commits. Strings on the same stride run exactly the single-rate scheme
+    // at that stride.
+    //
+    // The implicit scheme runs both strings on one stride instead and steps
+    // them together with the bridge (stepImplicit).
+    void stepOnce() {
+        if (!allAsleep()) {
+            if (implicitScheme) {
+                if ((stepCount + 1) % string1.stride == 0) stepImplicit();
+            } else {
+                stepExplicit();
+            }
+
+            markEnergyDirty();
+        }
+
+        stepCount++;
+
+        if (stepCount % SLEEP_INTERVAL == 0) {
+            updateSleep();
+        }
+
+        // Record history
+        if (stepCount % historyInterval == 0) {
+            recordHistory();
+        }
+    }
+
+    // Advances the clock by numSteps base steps after they were computed in
+    // one go: sleep check and history at the end if a mark fell inside
+    void advanceClock(int numSteps) {
+        bool check = stepCount % SLEEP_INTERVAL + numSteps >= SLEEP_INTERVAL;
+        bool record = stepCount % historyInterval + numSteps >= historyInterval;
+        stepCount += numSteps;
+        if (check) {
+            updateSleep();
+        }
+        if (record) {
+            recordHistory();
+        }
+    }
+
+    void stepExplicit() {
+        // ================================================================
+        // Step 1: Strings starting a substep update their interior points
+        // Both strings: fixed at left (x=0), bridge end set in step 3
+        // ================================================================
+        beginSubstep(string1);
+        beginSubstep(string2);
+
+        // ================================================================
+        // Step 2: RIGID BRIDGE CONSTRAINT (at the end of each bridge step)
+        // What each string "wants" at the bridge, from the wave equation
+        // extrapolated to the boundary; both strings must share the result.
+        // Position is weighted average based on tension (stiffness)
+        // ================================================================
+        int stride = bridgeStride();
+        if ((stepCount + 1) % stride == 0) {
+            int64_t start = stepCount + 1 - stride;
+            solveBridge(bridgeWant(string1, bridgeNeighbor(string1, start), stride),
+                        bridgeWant(string2, bridgeNeighbor(string2, start), stride), stride);
+        }
+
+        // ================================================================
+        // Step 3: Strings ending a substep take the bridge position and
+        // commit their new level
+        // ================================================================
+        endSubstep(string1);
+        endSubstep(string2);
+    }
+
+    // Base steps per bridge step
+    int bridgeStride() const { return std::min(string1.stride, string2.stride); }
+
+    // Courant number squared over `stride` base steps of a string. Kernel
+    // damping is per step, so a step of `stride` base steps damps `stride`
+    // times as much.
+    Real courantSq(const StringState& s, int stride) const {
+        Real r = s.waveSpeed * (dt * stride) / s.dx();
+        return r * r;
+    }
+
+    Real substepCourantSq(const StringState& s) const { return courantSq(s, s.stride); }
+    Real substepDamping(const StringState& s) const { return s.damping * s.stride; }
+
+    void beginSubstep(StringState& s) {
+        if (s.asleep || stepCount % s.stride != 0) return;
+
+        // Interior points - standard wave equation (see stencil_kernels.h)
+        s.y_next[0] = 0.0f;
+        kernels->interior(s.y.data(), s.y_prev.data(), s.y_next.data(), s.numPoints,
+                          substepCourantSq(s), substepDamping(s), dt * s.stride);
+        s.inFlight = true;
+    }
+
+    // The string's last interior point at base step `step`: its committed
+    // value, moved linearly toward the substep's new level
+    Real bridgeNeighbor(const StringState& s, int64_t step) const {
+        const int N = s.numPoints;
+        if (!s.inFlight) return s.y[N-2];
+
+        int k = static_cast<int>(step % s.stride);
+        return s.y[N-2] + (s.y_next[N-2] - s.y[N-2]) * k / s.stride;
+    }
+
+    void endSubstep(StringState& s) {
+        if (!s.inFlight || (stepCount + 1) % s.stride != 0) return;
+
+        const int N = s.numPoints;
+        s.y_next[N-1] = bridgeY;
+
+        // Store force for visualization
+        Real slope = (s.y_next[N-1] - s.y_next[N-2]) / s.dx();
+        s.forceOnBridge = -s.tension * slope;
+
+        kernels->commit(s.y.data(), s.y_prev.data(), s.v.data(), s.y_next.data(), N,
+                        dt * s.stride);
+        s.inFlight = false;
+    }
+
+    // What a string "wants" at its right end (based on its neighbor), from
+    // the wave equation extrapolated to the boundary over one bridge step
+    Real bridgeWant(const StringState& s, Real neighbor, int stride) const {
+        Real stepDt = dt * stride;
+        return 2.0f * bridgeY - bridgePrevY
+             + courantSq(s, stride) * (neighbor - 2.0f * bridgeY + bridgeY)
+             - s.damping * stride * stepDt * (bridgeY - bridgePrevY) / stepDt;
+    }
+
+    // Tension-weighted equilibrium of both wants; updates bridgeY / bridgeV
+    Real solveBridge(Real y1_want, Real y2_want, int stride = 1) {
+        Real totalTension = string1.tension + string2.tension;
+        Real newBridgeY = (string1.tension * y1_want + string2.tension * y2_want) / totalTension;
+        return settleBridge(newBridgeY, stride);
+    }
+
+    // Moves the bridge toward its equilibrium over one bridge step of
+    // `stride` base steps. bridgeStiffness is a blend per base step,
+    // compounded over the stride.
+    Real settleBridge(Real newBridgeY, int stride) {
+        // Apply stiffness parameter (1.0 = perfectly rigid)
+        Real stiffness = bridgeStiffness;
+        if (stride > 1) stiffness = 1.0f - std::pow(1.0f - bridgeStiffness, static_cast<Real>(stride));
+        newBridgeY = stiffness * newBridgeY + (1.0f - stiffness) * bridgeY;
+
+        // Safety clamp
+        newBridgeY = std::max<Real>(-0.5f, std::min<Real>(0.5f, newBridgeY));
+        if (!std::isfinite(newBridgeY)) newBridgeY = 0.0f;
+
+        // Track velocity for display
+        bridgeV = (newBridgeY - bridgeY) / (dt * stride);
+        bridgePrevY = bridgeY;
+        bridgeY = newBridgeY;
+
+        // A moving bridge re-excites sleeping strings
+        if ((string1.asleep || string2.asleep) && !bridgeQuiet()) {
+            wakeString(string1, true);
+            wakeString(string2, true);
+        }
+        return bridgeY;
+    }
+
+    // A sleeping string is zero, so the substep it skipped since its last
+    // boundary is zero as well: it joins that substep in flight and takes
+    // the bridge when it ends, instead of holding its end at rest for up to
+    // a whole substep while the bridge moves. inStep: called inside step
+    // stepCount, whose beginSubstep already passed it by. The implicit
+    // scheme has no substeps in flight.
+    void wakeString(StringState& s, bool inStep) {
+        if (!s.asleep) return;
+        s.asleep = false;
+        if (implicitScheme) return;
+
+        std::fill(s.y_next.begin(), s.y_next.begin() + s.numPoints, 0.0f);
+        s.inFlight = inStep || stepCount % s.stride != 0;
+    }
+
+    // ========================================================================
+    // Implicit Step (θ-scheme, see ThetaSystem)
+    // ========================================================================
+    // One step of OVERSAMPLING / implicitSubsteps base steps for both strings
+    // and the bridge. The bridge couples the two tridiagonal systems only
+    // through their last equations (a rank-one term each), so each system is
+    // solved as if the bridge were known:
+    //
+    //   1. forward pass: the last unknown comes out as P + Q * b+, with the
+    //      correction Q = λθ * inv[last] for the bridge value b+ still unknown
+    //   2. the bridge end's own θ-scheme equation (the same half stencil as
+    //      bridgeWant) is then scalar in b+, solved tension-weighted
+    //   3. P += Q * b+, backward pass
+    void stepImplicit() {
+        const int N = string1.numPoints;  // Both strings, see fitGrid
+        const int m = N - 2;              // Interior unknowns
+        const int stride = string1.stride;
+        Real stepDt = dt * stride;
+
+        StringState* strings[2] = { &string1, &string2 };
+        ThetaSystem* systems[2] = { &theta1, &theta2 };
+        Real lambda[2], damping[2];
+
+        for (int s = 0; s < 2; s++) {
+            StringState& str = *strings[s];
+            lambda[s] = courantSq(str, stride);
+            damping[s] = substepDamping(str);
+            systems[s]->prepare(lambda[s], damping[s], N);
+            thetaRhs(str.y.data(), str.y_prev.data(), str.y_next.data(), N, lambda[s], damping[s]);
+        }
+
+        // Solutions land in y_next[1 .. N-2]
+        Real* x1 = string1.y_next.data() + 1;
+        Real* x2 = string2.y_next.data() + 1;
+        forwardTridiagonalPair(x1, theta1.inv.data(), theta1.mult.data(), theta1.pair.data(),
+                               x2, theta2.inv.data(), theta2.mult.data(), theta2.pair.data(), m);
+
+        // Bridge end: coef * b+ = rhs per string, summed with tension weights
+        Real coefSum = 0.0f, rhsSum = 0.0f;
+        Real correction[2];
+        for (int s = 0; s < 2; s++) {
+            const StringState& str = *strings[s];
+            const Real* y = str.y.data();
+            const Real* yPrev = str.y_prev.data();
+            Real implicitPart = lambda[s] * IMPLICIT_THETA;
+            Real P = str.y_next[N-2];
+            correction[s] = implicitPart * systems[s]->inv[m-1];
+
+            Real coef = 1.0f + 0.5f * damping[s] + implicitPart * (1.0f - correction[s]);
+            Real rhs = 2.0f * y[N-1] - (1.0f - 0.5f * damping[s]) * yPrev[N-1]
+                      + implicitPart * P
+                      + lambda[s] * (1.0f - 2.0f * IMPLICIT_THETA) * (y[N-2] - y[N-1])
+                      + implicitPart * (yPrev[N-2] - yPrev[N-1]);
+            coefSum += str.tension * coef;
+            rhsSum += str.tension * rhs;
+        }
+        Real b = settleBridge(rhsSum / coefSum, stride);
+
+        x1[m-1] += correction[0] * b;
+        x2[m-1] += correction[1] * b;
+        backTridiagonalPair(x1, theta1.mult.data(), theta1.pair.data(),
+                            x2, theta2.mult.data(), theta2.pair.data(), m);
+
+        for (int s = 0; s < 2; s++) {
+            StringState& str = *strings[s];
+            str.y_next[0] = 0.0f;
+            str.y_next[N-1] = b;
+
+            // Store force for visualization
+            Real slope = (str.y_next[N-1] - str.y_next[N-2]) / str.dx();
+            str.forceOnBridge = -str.tension * slope;
+
+            kernels->commit(str.y.data(), str.y_prev.data(), str.v.data(), str.y_next.data(), N,
+                            stepDt);
+        }
+    }
+
+    // ========================================================================
+    // Fused Substeps (temporal blocking, see temporal_blocking.h)
+    // ========================================================================
+    // Same result as step(numSteps): bit-identical string state, bridge and
+    // end-of-block energies. Only the history and sleep checks differ: when a
+    // mark falls inside the block they run with the end-of-block values.
+    // Diagnostics mode needs every substep's energy, so it steps normally.
+    //
+    // The sweep needs both strings on the same stride, starting on a substep
+    // boundary and covering whole substeps; anything else steps normally, as
+    // does the implicit scheme (few steps, each a full solve) and a pair with
+    // one string asleep.
+    void stepFused(int numSteps) {
+        if (numSteps <= 0) return;
+
+        if (allAsleep()) {
+            advanceClock(numSteps);
+            return;
+        }
+
+        const int stride = string1.stride;
+        if (energyDiagnostics || implicitScheme || string2.stride != stride || string1.inFlight || string2.inFlight
+            || string1.asleep || string2.asleep || stepCount % stride != 0 || numSteps % stride != 0) {
+            step(numSteps);
+            return;
+        }
+
+        const int N1 = string1.numPoints;
+        const int N2 = string2.numPoints;
+
+        // Levels -1 and 0 are y_prev and y; y_next is the third buffer. The
+        // sweep aligns the two grids at the bridge.
+        BasicSweepString<Real> sweep[2] = {
+            {{string1.y_prev.data(), string1.y.data(), string1.y_next.data()}, N1,
+             substepCourantSq(string1), substepDamping(string1)},
+            {{string2.y_prev.data(), string2.y.data(), string2.y_next.data()}, N2,
+             substepCourantSq(string2), substepDamping(string2)}
+        };
+
+        // Equal strides: one bridge step per level, as in stepOnce()
+        sweepSubsteps(sweep, 2, numSteps / stride, SWEEP_TILE, *kernels, dt * stride, [&](int k) {
+            Real y1_want = bridgeWant(string1, sweepLevel(sweep[0], k - 1)[N1-2], stride);
+            Real y2_want = bridgeWant(string2, sweepLevel(sweep[1], k - 1)[N2-2], stride);
+            Real b = solveBridge(y1_want, y2_want, stride);
+            sweepLevel(sweep[0], k)[N1-1] = b;
+            sweepLevel(sweep[1], k)[N2-1] = b;
+        });
+
+        settleLevels(string1, numSteps / stride, dt * stride);
+        settleLevels(string2, numSteps / stride, dt * stride);
+
+        // Store forces for visualization
+        Real slope1 = (string1.y[N1-1] - string1.y[N1-2]) / string1.dx();
+        Real slope2 = (string2.y[N2-1] - string2.y[N2-2]) / string2.dx();
+        string1.forceOnBridge = -string1.tension * slope1;
+        string2.forceOnBridge = -string2.tension * slope2;
+
+        markEnergyDirty();
+        advanceClock(numSteps);
+    }
+
+    // After a K-step sweep, moves the last two levels back into y / y_prev
+    // (so views over y stay valid) and sets v. Level L sits in buffer
+    // (L + 1) % 3 of {y_prev, y, y_next}.
+    void settleLevels(StringState& s, int K, Real stepDt) {
+        const int N = s.numPoints;
+        switch (K % 3) {
+            case 0:  // Last in y, previous in y_prev
+                for (int i = 0; i < N; i++) s.v[i] = (s.y[i] - s.y_prev[i]) / stepDt;
+                break;
+            case 1:  // Last in y_next, previous in y: a regular commit
+                kernels->commit(s.y.data(), s.y_prev.data(), s.v.data(), s.y_next.data(), N, stepDt);
+                break;
+            case 2:  // Last in y_prev, previous in y_next
+                std::copy(s.y_prev.begin(), s.y_prev.begin() + N, s.y.begin());
+                kernels->commit(s.y_next.data(), s.y_prev.data(), s.v.data(), s.y.data(), N, stepDt);
+                break;
+        }
+    }
+
+    // ========================================================================
+    // Idle Sleep
+    // ========================================================================
+    // Every SLEEP_INTERVAL base steps, once both strings' energies have
+    // decayed under SLEEP_ENERGY (relative to their tension, so the floor is
+    // the same amplitude at any pitch) while the bridge is still, both are
+    // zeroed and no longer stepped; a step then only advances the clock.
+    // They sleep together: a string held at rest while the other rings
+    // would change the ringing string's bridge end and pull it out of tune.
+    // A pluck wakes both, as does the bridge moving again (settleBridge).
+    void updateSleep() {
+        if (!bridgeQuiet()) return;
+
+        updateEnergy();
+        bool quiet1 = isQuiet(string1);
+        bool quiet2 = isQuiet(string2);
+        if (!((quiet1 || string1.asleep) && (quiet2 || string2.asleep))) return;
+
+        if (quiet1) sleepString(string1);
+        if (quiet2) sleepString(string2);
+        if (allAsleep()) {
+            bridgeY = 0.0f;
+            bridgePrevY = 0.0f;
+            bridgeV = 0.0f;
+        }
+    }
+
+    bool isQuiet(const StringState& s) const {
+        return !s.asleep && !s.inFlight && s.totalEnergy < SLEEP_ENERGY * s.tension;
+    }
+
+    bool bridgeQuiet() const {
+        return std::abs(bridgeY) < SLEEP_BRIDGE && std::abs(bridgeY - bridgePrevY) < SLEEP_BRIDGE;
+    }
+
+    bool allAsleep() const { return string1.asleep && string2.asleep; }
+
+    void sleepString(StringState& s) {
+        s.y.fill(0.0f);
+        s.y_prev.fill(0.0f);
+        s.v.fill(0.0f);
+        s.y_next.fill(0.0f);
+        s.forceOnBridge = 0.0f;
+        s.asleep = true;
+        markEnergyDirty();
+    }
+
+    // ========================================================================
+    // Energy
+    // ========================================================================
+    void markEnergyDirty() {
+        energyDirty = true;
+        if (energyDiagnostics) updateEnergy();
+    }
+
+    // Computes both strings' energies if anything changed since last time
+    void updateEnergy() {
+        if (!energyDirty) return;
+
+        computeEnergy(string1);
+        computeEnergy(string2);
+        energyDirty = false;
+
+        maxTotalEnergy = std::max(maxTotalEnergy, string1.totalEnergy + string2.totalEnergy);
+    }
+
+    // Opt-in exact per-substep energy (doubles the cost of a substep)
+    void setEnergyDiagnostics(bool enabled) {
+        energyDiagnostics = enabled;
+        maxTotalEnergy = 0.0f;
+        updateEnergy();
+    }
+
+    void computeEnergy(StringState& s) {
+        Real ke, pe;
+        kernels->energy(s.y.data(), s.v.data(), s.numPoints, s.density, s.tension, s.dx(), ke, pe);
+
+        s.kineticEnergy = ke;
+        s.potentialEnergy = pe;
+        s.totalEnergy = ke + pe;
+    }
+
+    void recordHistory() {
+        updateEnergy();
+
+        energy1History.push(string1.totalEnergy);
+        energy2History.push(string2.totalEnergy);
+        bridgeHistory.push(bridgeY);
+    }
+
+    // Capacity in samples and decimation in steps per sample; clears history
+    void setHistoryConfig(int capacity, int interval) {
+        size_t cap = static_cast<size_t>(std::max(2, capacity));
+        energy1History.setCapacity(cap);
+        energy2History.setCapacity(cap);
+        bridgeHistory.setCapacity(cap);
+        historyInterval = std::max(1, interval);
+    }
+
+    // ========================================================================
+    // Setters
+    // ========================================================================
+    void setString1Frequency(Real freq) {
+        string1.setFrequency(std::max<Real>(50.0f, std::min<Real>(1000.0f, freq)));
+        fitGrid(string1);
+    }
+
+    void setString2Frequency(Real freq) {
+        string2.setFrequency(std::max<Real>(50.0f, std::min<Real>(1000.0f, freq)));
+        fitGrid(string2);
+    }
+
+    // Substep stride and grid points a string gets in the current scheme
+    void gridFor(const StringState& s, int& stride, int& n) const {
+        if (implicitScheme) {
+            stride = OVERSAMPLING / implicitSubsteps;
+            n = Points;
+        } else {
+            stride = OVERSAMPLING / courantSubsteps(s.waveSpeed, s.length, Points);
+            n = courantPoints(s.waveSpeed, s.length, dt * stride, Points);
+        }
+    }
+
+    // Picks a string's substep rate and grid for its current wave speed (see
+    // courantSubsteps). The shape is resampled, so a retune mid-note keeps
+    // sounding; a substep in flight is dropped and the string waits for the
+    // next boundary of its new stride.
+    // The implicit scheme has no Courant limit: every string gets the full
+    // grid at implicitSubsteps.
+    void fitGrid(StringState& s) {
+        int stride, n;
+        gridFor(s, stride, n);
+        if (stride == s.stride && n == s.numPoints) return;
+
+        // Keep the velocity (y - y_prev) / step across a change of step
+        if (stride != s.stride) {
+            Real scale = static_cast<Real>(stride) / s.stride;
+            for (int i = 0; i < s.numPoints; i++) {
+                s.y_prev[i] = s.y[i] - (s.y[i] - s.y_prev[i]) * scale;
+            }
+        }
+
+        s.stride = stride;
+        s.inFlight = false;
+        if (n != s.numPoints) {
+            s.setNumPoints(n);
+            gridVersion++;
+        }
+        markEnergyDirty();
+    }
+
+    void setDamping(Real d) {
+        Real damping = std::max<Real>(0.0f, std::min<Real>(0.01f, d));
+        string1.damping = damping;
+        string2.damping = damping;
+    }
+
+    void setBridgeStiffness(Real s) {
+        bridgeStiffness = std::max<Real>(0.0f, std::min<Real>(1.0f, s));
+    }
+
+    // Switches between the explicit multi-rate leapfrog (default) and the
+    // implicit θ-scheme; the current state carries over
+    void setImplicit(bool enabled) {
+        implicitScheme = enabled;
+        fitGrid(string1);
+        fitGrid(string2);
+    }
+
+    // ========================================================================
+    // Getters
+    // ========================================================================
+    std::vector<Real> getString1Displacement() {
+        return std::vector<Real>(string1.y.begin(), string1.y.begin() + string1.numPoints);
+    }
+
+    std::vector<Real> getString2Displacement() {
+        return std::vector<Real>(string2.y.begin(), string2.y.begin() + string2.numPoints);
+    }
+
+    std::vector<Real> getString1Velocity() {
+        return std::vector<Real>(string1.v.begin(), string1.v.begin() + string1.numPoints);
+    }
+
+    std::vector<Real> getString2Velocity() {
+        return std::vector<Real>(string2.v.begin(), string2.v.begin() + string2.numPoints);
+    }
+
+    std::vector<float> getEnergy1History() { return energy1History.toVector(); }
+    std::vector<float> getEnergy2History() { return energy2History.toVector(); }
+    std::vector<float> getBridgeHistory() { return bridgeHistory.toVector(); }
+    int getHistoryCapacity() { return static_cast<int>(energy1History.capacity()); }
+    int getHistoryInterval() { return historyInterval; }
+
+    // Seconds simulated, from the step count: accumulating dt would stall
+    // once the clock's ulp outgrows dt (about an hour in float)
+    Real getTime() const {
+        return static_cast<Real>(static_cast<double>(stepCount) / (static_cast<double>(SAMPLE_RATE) * OVERSAMPLING));
+    }
+    Real getEnergy1() { updateEnergy(); return string1.totalEnergy; }
+    Real getEnergy2() { updateEnergy(); return string2.totalEnergy; }
+    Real getKinetic1() { updateEnergy(); return string1.kineticEnergy; }
+    Real getKinetic2() { updateEnergy(); return string2.kineticEnergy; }
+    Real getPotential1() { updateEnergy(); return string1.potentialEnergy; }
+    Real getPotential2() { updateEnergy(); return string2.potentialEnergy; }
+    Real getTotalEnergy() { updateEnergy(); return string1.totalEnergy + string2.totalEnergy; }
+    // Peak total over every computed value (every substep in diagnostics mode)
+    Real getMaxTotalEnergy() { updateEnergy(); return maxTotalEnergy; }
+    bool getEnergyDiagnostics() { return energyDiagnostics; }
+    bool getImplicit() { return implicitScheme; }
+    int getImplicitSubsteps() { return implicitSubsteps; }
+    Real getBridgeY() { return bridgeY; }
+    Real getBridgeV() { return bridgeV; }
+    Real getForce1() { return string1.forceOnBridge; }
+    Real getForce2() { return string2.forceOnBridge; }
+    Real getString1Frequency() { return string1.frequency; }
+    Real getString2Frequency() { return string2.frequency; }
+    int getString1NumPoints() { return string1.numPoints; }
+    int getString2NumPoints() { return string2.numPoints; }
+    int getString1Substeps() { return OVERSAMPLING / string1.stride; }
+    int getString2Substeps() { return OVERSAMPLING / string2.stride; }
+    bool getString1Asleep() { return string1.asleep; }
+    bool getString2Asleep() { return string2.asleep; }
+
+    // ========================================================================
+    // DSP Load
+    // ========================================================================
+    // Render time over real time of the renderBlock calls (load_meter.h):
+    // 1.0 is a block that took as long as it plays. Safe to read from any
+    // thread while another renders.
+    float getDspLoad() const { return loadMeter.load(); }
+    float getWorstDspLoad() const { return loadMeter.worst(); }
+    float getDspLoadPercentile(float p) const { return loadMeter.percentile(p); }
+    int getOverruns() const { return static_cast<int>(loadMeter.overrunCount()); }
+    int getTimedBlocks() const { return static_cast<int>(loadMeter.blockCount()); }
+    int getLoadHistogram(int bin) const { return static_cast<int>(loadMeter.bin(bin)); }
+    void resetLoadStats() { loadMeter.reset(); }
+    void setLoadMetering(bool enabled) { loadMeter.setEnabled(enabled); }
+
+    // ========================================================================
+    // Snapshots
+    // ========================================================================
+    // Whole simulation state as bytes (format in snapshot.h): both strings'
+    // levels and parameters, bridge, clock, scheme, histories and pending
+    // events. saveState writes into `out` and returns the size, or 0 if
+    // `capacity` is too small (snapshotSize() tells how much is needed).
+    size_t snapshotSize() const {
+        SnapshotWriter w(nullptr, 0);
+        const_cast<BasicSympatheticStrings*>(this)->transferState(w);
+        return w.size();
+    }
+
+    size_t saveState(uint8_t* out, size_t capacity) const {
+        SnapshotWriter w(out, capacity);
+        const_cast<BasicSympatheticStrings*>(this)->transferState(w);
+        return w.ok() ? w.size() : 0;
+    }
+
+    std::vector<uint8_t> saveState() const {
+        std::vector<uint8_t> out(snapshotSize());
+        saveState(out.data(), out.size());
+        return out;
+    }
+
+    // Restores a snapshot of the same engine type and version. On a
+    // malformed one it returns false and leaves the engine as freshly
+    // constructed (default scheme and history), keeping only its kernels
+    // and load statistics.
+    bool restoreState(const uint8_t* data, size_t size) {
+        SnapshotReader r(data, size);
+        transferState(r);
+        if (!r.ok() || !restoredGridValid(string1) || !restoredGridValid(string2)) {
+            const BasicStencilKernels<Real>* keep = kernels;
+            int version = gridVersion;
+            *this = std::move(*std::make_unique<BasicSympatheticStrings>());
+            kernels = keep;
+            gridVersion = version + 1;
+            return false;
+        }
+
+        // Derived state: implicit factors and energies are rebuilt on demand
+        theta1.numPoints = 0;
+        theta2.numPoints = 0;
+        energyDirty = true;
+        gridVersion++;
+        return true;
+    }
+
+    // Copies the whole state into another engine, typically one kept around
+    // for branching; nothing is allocated while its history capacity is
+    // at least this one's
+    void forkInto(BasicSympatheticStrings& slot) const {
+        if (&slot != this) slot = *this;
+    }
+
+    // Every field that defines the simulation, in snapshot order
+    template <typename Io>
+    void transferState(Io& io) {
+        if (!io.header("SSTR", STRINGS_SNAPSHOT_VERSION, sizeof(Real), Points)) return;
+
+        transferString(io, string1);
+        transferString(io, string2);
+
+        io.value(bridgeY);
+        io.value(bridgePrevY);
+        io.value(bridgeV);
+        io.value(bridgeStiffness);
+        io.value(stepCount);
+
+        io.flag(implicitScheme);
+        io.divisor(implicitSubsteps, OVERSAMPLING);
+        io.flag(energyDiagnostics);
+        io.value(maxTotalEnergy);
+
+        io.count(historyInterval, 1, MAX_SNAPSHOT_HISTORY);
+        transferHistory(io, energy1History);
+        transferHistory(io, energy2History);
+        transferHistory(io, bridgeHistory);
+
+        transferEvents(io, events);
+    }
+
+    template <typename Io>
+    static void transferString(Io& io, StringState& s) {
+        if (!io.count(s.numPoints, MIN_POINTS, Points)) return;
+        io.array(s.y.data(), s.numPoints);
+        io.array(s.y_prev.data(), s.numPoints);
+        io.array(s.v.data(), s.numPoints);
+        io.array(s.y_next.data(), s.numPoints);
+
+        io.value(s.frequency);
+        io.value(s.tension);
+        io.value(s.density);
+        io.value(s.damping);
+        io.value(s.waveSpeed);
+        io.value(s.length);
+        io.divisor(s.stride, OVERSAMPLING);
+        io.flag(s.inFlight);
+        io.flag(s.asleep);
+        io.value(s.forceOnBridge);
+    }
+
+    // A restored string must have finite, positive parameters, the wave
+    // speed they give, and the stride and grid fitGrid would pick for them
+    // in the restored scheme (anything else can break the Courant limit or,
+    // implicit, the shared grid stepImplicit assumes)
+    bool restoredGridValid(const StringState& s) const {
+        bool finite = std::isfinite(s.frequency) && std::isfinite(s.tension) && std::isfinite(s.density)
+                   && std::isfinite(s.damping) && std::isfinite(s.length);
+        if (!finite || !(s.tension > 0.0f && s.density > 0.0f && s.length > 0.0f && s.damping >= 0.0f)) {
+            return false;
+        }
+        if (s.waveSpeed != std::sqrt(s.tension / s.density)) return false;
+
+        int stride, n;
+        gridFor(s, stride, n);
+        return stride == s.stride && n == s.numPoints;
+    }
+
+    // Capacity, then the values oldest first
+    template <typename Io>
+    static void transferHistory(Io& io, HistoryRing& ring) {
+        int cap = static_cast<int>(ring.capacity());
+        int n = static_cast<int>(ring.size());
+        if (!io.count(cap, 1, MAX_SNAPSHOT_HISTORY) || !io.count(n, 0, cap)
+            || !io.expect(static_cast<size_t>(n) * sizeof(float))) {
+            return;
+        }
+
+        if (Io::reading) {
+            if (static_cast<size_t>(cap) != ring.capacity()) ring.setCapacity(cap);
+            ring.clear();
+            for (int i = 0; i < n; i++) {
+                float value = 0.0f;
+                io.value(value);
+                ring.push(value);
+            }
+        } else {
+            io.array(const_cast<float*>(ring.headData()), ring.headSize());
+            io.array(const_cast<float*>(ring.tailData()), ring.tailSize());
+        }
+    }
+
+    void reset() {
+        string1 = StringState();
+        string2 = StringState();
+        string1.setFrequency(261.63f);
+        string2.setFrequency(392.00f);
+        fitGrid(string1);
+        fitGrid(string2);
+        bridgeY = 0.0f;
+        bridgePrevY = 0.0f;
+        bridgeV = 0.0f;
+        bridgeStiffness = 1.0f;
+        stepCount = 0;
+        energyDirty = false;
+        maxTotalEnergy = 0.0f;
+        energy1History.clear();
+        energy2History.clear();
+        bridgeHistory.clear();
+        events.clear();
+    }
+
+    Real getBridgeStiffness() { return bridgeStiffness; }
+};
+
+using SympatheticStrings = BasicSympatheticStrings<float, NUM_POINTS>;
@@ -0,0 +1,277 @@
+/**
+ * Physics Worker - SympatheticStrings on its own thread
+ *
+ * Rendering inside the audio callback puts the whole FDTD cost on the
+ * audio deadline, and in the browser that callback shares the main thread
+ * with the UI. PhysicsWorker moves the engine onto a dedicated thread:
+ *
+ *   UI thread ── commands (SpscQueue) ──> worker: SympatheticStrings
+ *       ^                                   │           │
+ *       └── display (triple buffer) <───────┘           │ blocks
+ *                                                       v
+ *   audio callback <──────── copy only ──────── AudioRing (SPSC)
+ *
+ * Pacing uses two watermarks. Once the ring holds highWatermark frames the
+ * worker sleeps until it has drained to about lowWatermark, then refills.
+ * Audio latency is the ring fill, so the watermarks trade latency against
+ * headroom for a worker that gets descheduled. Commands (plucks,
+ * parameters) are applied between blocks, so they are heard one ring fill
+ * later.
+ *
+ * Only the worker touches the engine. The UI reads a PhysicsDisplay copy
+ * published every DISPLAY_FRAMES through a triple buffer: the worker never
+ * waits for the reader, and a reader never sees a half-written copy.
+ *
+ * When not streaming (audio off) the worker renders nothing and only runs
+ * commands, so step() commands drive the simulation for the visuals.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+#include "physics.h"
+#include "spsc_ring.h"
+
+constexpr int WORKER_RING_FRAMES = 8192;  // Ring capacity (~186 ms)
+constexpr int WORKER_BLOCK = 128;         // Frames rendered per block
+constexpr int WORKER_LOW_WATERMARK = 512;
+constexpr int WORKER_HIGH_WATERMARK = 1024;
+constexpr int WORKER_COMMANDS = 256;
+constexpr int DISPLAY_FRAMES = 735;       // Audio frames between displays (60 Hz)
+
+// What the UI shows of the engine, copied out by the worker
+struct PhysicsDisplay {
+    std::array<float, NUM_POINTS> y1;
+    std::array<float, NUM_POINTS> y2;
+    int numPoints1 = 0;
+    int numPoints2 = 0;
+
+    float time = 0.0f;
+    float energy1 = 0.0f;
+    float energy2 = 0.0f;
+    float bridgeY = 0.0f;
+    float force1 = 0.0f;
+    float force2 = 0.0f;
+
+    // Histories, oldest first
+    std::array<float, HISTORY_LENGTH> energy1History;
+    std::array<float, HISTORY_LENGTH> energy2History;
+    std::array<float, HISTORY_LENGTH> bridgeHistory;
+    int historySize = 0;
+};
+
+class PhysicsWorker {
+public:
+    PhysicsWorker() : thread([this] { run(); }) {}
+
+    ~PhysicsWorker() {
+        stopping.store(true, std::memory_order_relaxed);
+        thread.join();
+    }
+
+    PhysicsWorker(const PhysicsWorker&) = delete;
+    PhysicsWorker& operator=(const PhysicsWorker&) = delete;
+
+    // ========================================================================
+    // Commands (one UI thread)
+    // ========================================================================
+    // A full queue drops the command: the UI must never block on physics
+    void pluck(int stringIndex, float position, float amplitude) {
+        send({PLUCK, stringIndex, position, amplitude});
+    }
+    void step(int numSteps) { send({STEP, numSteps, 0.0f, 0.0f}); }
+    void reset() { send({RESET, 0, 0.0f, 0.0f}); }
+
+    void setString1Frequency(float freq) {
+        f1 = std::max(50.0f, std::min(1000.0f, freq));
+        send({FREQUENCY, 0, freq, 0.0f});
+    }
+    void setString2Frequency(float freq) {
+        f2 = std::max(50.0f, std::min(1000.0f, freq));
+        send({FREQUENCY, 1, freq, 0.0f});
+    }
+    void setDamping(float d) { send({DAMPING, 0, d, 0.0f}); }
+    void setBridgeStiffness(float s) { send({STIFFNESS, 0, s, 0.0f}); }
+    void setImplicit(bool enabled) { send({IMPLICIT, enabled ? 1 : 0, 0.0f, 0.0f}); }
+
+    // Pickup of the streamed audio, 0..1
+    void setPickup(float pos) { send({PICKUP, 0, pos, 0.0f}); }
+
+    // Starts or stops rendering into the ring. Starting has the audio side
+    // drop whatever was left over from before at its next read.
+    void setStreaming(bool enabled) {
+        if (enabled) ring.requestFlush();
+        streaming.store(enabled, std::memory_order_release);
+    }
+
+    // Fill levels the worker keeps the ring between (frames)
+    void setWatermarks(int low, int high) {
+        high = std::max(WORKER_BLOCK, std::min(WORKER_RING_FRAMES - WORKER_BLOCK, high));
+        low = std::max(0, std::min(high - WORKER_BLOCK, low));
+        lowWatermark.store(low, std::memory_order_relaxed);
+        highWatermark.store(high, std::memory_order_relaxed);
+    }
+
+    // Frequencies as last set, without waiting for the worker
+    float getString1Frequency() const { return f1; }
+    float getString2Frequency() const { return f2; }
+
+    // ========================================================================
+    // Audio (one audio thread)
+    // ========================================================================
+    // Copies numFrames from the ring, zero-filling on underrun; returns the
+    // frames that came from the ring
+    int readAudio(int numFrames, float* outL, float* outR) {
+        int n = ring.read(outL, outR, numFrames);
+        if (n < numFrames) underruns.fetch_add(1, std::memory_order_relaxed);
+        return n;
+    }
+
+    AudioRing<WORKER_RING_FRAMES>& audioRing() { return ring; }
+    int getUnderruns() const { return underruns.load(std::memory_order_relaxed); }
+
+    // DSP load of the worker's renderBlock calls (load_meter.h). The meter's
+    // atomics are the one part of the worker's engine other threads may read.
+    const LoadMeter& loadMeter() const { return sim.loadMeter; }
+    void resetLoadStats() { sim.loadMeter.reset(); }
+
+    // ========================================================================
+    // Display (the UI thread)
+    // ========================================================================
+    // Switches to the newest published display if there is one; returns
+    // whether it changed. display() stays valid until the next latch.
+    bool latchDisplay() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+        displayVersion++;
+        return true;
+    }
+
+    const PhysicsDisplay& display() const { return buffers[front]; }
+
+    // Moves with every latch (views into display() must be refetched)
+    uint32_t displayVersion = 0;
+
+private:
+    enum CommandType { PLUCK, STEP, RESET, FREQUENCY, DAMPING, STIFFNESS, IMPLICIT, PICKUP };
+
+    struct Command {
+        CommandType type;
+        int index;
+        float a;
+        float b;
+    };
+
+    SympatheticStrings sim;  // Worker thread only
+    float pickup = 0.3f;
+    int framesSinceDisplay = 0;
+
+    SpscQueue<Command, WORKER_COMMANDS> commands;
+    AudioRing<WORKER_RING_FRAMES> ring;
+    std::atomic<bool> streaming{false};
+    std::atomic<int> lowWatermark{WORKER_LOW_WATERMARK};
+    std::atomic<int> highWatermark{WORKER_HIGH_WATERMARK};
+    std::atomic<int> underruns{0};
+
+    // Triple buffer: the worker owns `back`, the reader owns `front`, and
+    // `middle` holds the last one published (FRESH until the reader takes it)
+    static constexpr int FRESH = 4;
+    PhysicsDisplay buffers[3];
+    int back = 0;
+    std::atomic<int> middle{1};
+    int front = 2;
+
+    float f1 = 261.63f;
+    float f2 = 392.00f;
+
+    std::atomic<bool> stopping{false};
+    std::thread thread;  // Last: starts once everything above exists
+
+    void send(const Command& command) { commands.push(command); }
+
+    void run() {
+        DenormalGuard guard;
+        float blockL[WORKER_BLOCK], blockR[WORKER_BLOCK];
+        publishDisplay();
+
+        while (!stopping.load(std::memory_order_relaxed)) {
+            applyCommands();
+
+            int fill = WORKER_RING_FRAMES - ring.space();
+            if (streaming.load(std::memory_order_acquire)
+                && fill < highWatermark.load(std::memory_order_relaxed)) {
+                sim.renderBlock(WORKER_BLOCK, pickup, blockL, blockR);
+                ring.write(blockL, blockR, WORKER_BLOCK);
+
+                framesSinceDisplay += WORKER_BLOCK;
+                if (framesSinceDisplay >= DISPLAY_FRAMES) publishDisplay();
+                continue;
+            }
+
+            // Full (or idle): sleep about as long as the ring takes to drain
+            // to the low watermark, but wake often enough for commands
+            int excess = fill - lowWatermark.load(std::memory_order_relaxed);
+            float seconds = std::max(0, excess) / SAMPLE_RATE;
+            std::this_thread::sleep_for(std::chrono::duration<float>(
+                std::max(0.0005f, std::min(0.004f, seconds))));
+        }
+    }
+
+    void applyCommands() {
+        Command c;
+        bool changed = false;
+        while (commands.pop(c)) {
+            switch (c.type) {
+                case PLUCK: sim.pluck(c.index, c.a, c.b); break;
+                case STEP: sim.step(c.index); break;
+                case RESET: sim.reset(); break;
+                case FREQUENCY:
+                    if (c.index == 0) sim.setString1Frequency(c.a);
+                    else sim.setString2Frequency(c.a);
+                    break;
+                case DAMPING: sim.setDamping(c.a); break;
+                case STIFFNESS: sim.setBridgeStiffness(c.a); break;
+                case IMPLICIT: sim.setImplicit(c.index != 0); break;
+                case PICKUP: pickup = std::max(0.0f, std::min(1.0f, c.a)); break;
+            }
+            changed = true;
+        }
+
+        // Without audio, commands are the only thing that moves the engine
+        if (changed && !streaming.load(std::memory_order_relaxed)) publishDisplay();
+    }
+
+    void publishDisplay() {
+        PhysicsDisplay& d = buffers[back];
+        d.numPoints1 = sim.string1.numPoints;
+        d.numPoints2 = sim.string2.numPoints;
+        std::copy(sim.string1.y.begin(), sim.string1.y.begin() + d.numPoints1, d.y1.begin());
+        std::copy(sim.string2.y.begin(), sim.string2.y.begin() + d.numPoints2, d.y2.begin());
+
+        d.time = sim.getTime();
+        d.energy1 = sim.getEnergy1();
+        d.energy2 = sim.getEnergy2();
+        d.bridgeY = sim.getBridgeY();
+        d.force1 = sim.getForce1();
+        d.force2 = sim.getForce2();
+
+        d.historySize = static_cast<int>(std::min<size_t>(HISTORY_LENGTH, sim.energy1History.size()));
+        copyHistory(sim.energy1History, d.energy1History.data(), d.historySize);
+        copyHistory(sim.energy2History, d.energy2History.data(), d.historySize);
+        copyHistory(sim.bridgeHistory, d.bridgeHistory.data(), d.historySize);
+
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+        framesSinceDisplay = 0;
+    }
+
+    // Newest `count` values of a ring, oldest first
+    static void copyHistory(const HistoryRing& ring, float* out, int count) {
+        size_t skip = ring.size() - count;
+        for (int i = 0; i < count; i++) out[i] = ring[skip + i];
+    }
+};
@@ -0,0 +1,379 @@
+/**
+ * Pluck Cache - recorded pluck responses played back by superposition
+ *
+ * Between parameter changes the rigid-bridge model is linear and
+ * time-invariant: a pluck at a given position always produces the same
+ * pickup signal, scaled by its amplitude. PluckCache records that signal once
+ * per configuration
+ *
+ *     (f1, f2, stiffness, damping, implicit, pickup, string, pluck position)
+ *
+ * and plays later plucks of the same configuration as scaled copies, summed
+ * like voices. A repeated pluck then costs one multiply-add per sample
+ * instead of a whole FDTD run.
+ *
+ *   pluck ── cached? ──yes──> voice: gain * response[frame++]  ─┐
+ *               │                                               + ─> out
+ *               no ──> live SympatheticStrings (FDTD) ──────────┘
+ *                      + request the response in the background
+ *
+ * A miss falls back to the live engine, so a new configuration sounds right
+ * away and only gets cheap once its response is ready. The live engine
+ * sleeps when silent (physics.h), so with every pluck cached it costs
+ * almost nothing.
+ *
+ * A response is recorded at amplitude 1 until both strings go to sleep, or
+ * for at most RESPONSE_SECONDS with a short fade. Cached voices add up,
+ * whereas SympatheticStrings::pluck replaces the string's shape, so
+ * re-plucking a ringing string sounds like two plucks rather than a damped
+ * restart. Parameter changes only affect later plucks; voices keep
+ * ringing as recorded.
+ *
+ * Threads: pluck / renderBlock / setters belong to the audio thread.
+ * Responses are computed by computePending(), either on a second thread
+ * (PluckCacheWorker, native) or in slices from the same thread between audio
+ * callbacks (the browser build, e.g. from requestIdleCallback). Slots hand
+ * over through an atomic state, and the audio thread never allocates or
+ * waits.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+#include "physics.h"
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#include <chrono>
+#include <thread>
+#endif
+
+constexpr int PLUCK_CACHE_SLOTS = 8;      // Cached configurations
+constexpr int PLUCK_CACHE_VOICES = 16;    // Cached plucks sounding at once
+constexpr float RESPONSE_SECONDS = 12.0f; // Longest recorded response
+constexpr int RESPONSE_FADE = 2048;       // Fade-out frames when cut at the limit
+constexpr int RESPONSE_CHUNK = 256;       // Frames recorded per renderBlock
+
+struct PluckKey {
+    float f1 = 0.0f;
+    float f2 = 0.0f;
+    float stiffness = 0.0f;
+    float damping = 0.0f;
+    float pickup = 0.0f;
+    float position = 0.0f;
+    int stringIndex = 0;
+    bool implicit = false;
+
+    bool operator==(const PluckKey& o) const {
+        return f1 == o.f1 && f2 == o.f2 && stiffness == o.stiffness && damping == o.damping
+            && pickup == o.pickup && position == o.position && stringIndex == o.stringIndex
+            && implicit == o.implicit;
+    }
+};
+
+class PluckCache {
+public:
+    SympatheticStrings live;  // Fallback engine, parameters always current
+
+    PluckCache() {
+        params.f1 = live.getString1Frequency();
+        params.f2 = live.getString2Frequency();
+        params.stiffness = live.getBridgeStiffness();
+        params.damping = live.string1.damping;
+        params.pickup = 0.3f;
+    }
+
+    // ========================================================================
+    // Parameters (audio thread)
+    // ========================================================================
+    void setString1Frequency(float freq) {
+        live.setString1Frequency(freq);
+        params.f1 = live.getString1Frequency();
+    }
+
+    void setString2Frequency(float freq) {
+        live.setString2Frequency(freq);
+        params.f2 = live.getString2Frequency();
+    }
+
+    void setDamping(float d) {
+        live.setDamping(d);
+        params.damping = live.string1.damping;
+    }
+
+    void setBridgeStiffness(float s) {
+        live.setBridgeStiffness(s);
+        params.stiffness = live.getBridgeStiffness();
+    }
+
+    void setImplicit(bool enabled) {
+        live.setImplicit(enabled);
+        params.implicit = enabled;
+    }
+
+    // ========================================================================
+    // Playback (audio thread)
+    // ========================================================================
+    // Plays the cached response if there is one, otherwise plucks the live
+    // engine and asks for the response to be recorded
+    void pluck(int stringIndex, float position, float amplitude) {
+        position = std::max(0.1f, std::min(0.9f, position));
+        amplitude = std::max(0.0f, std::min(1.0f, amplitude));
+
+        PluckKey key = keyFor(stringIndex, position);
+        int slot = findSlot(key);
+        if (slot >= 0 && slots[slot].state.load(std::memory_order_acquire) == READY) {
+            startVoice(slot, amplitude);
+            return;
+        }
+
+        live.pluck(stringIndex, position, amplitude);
+        if (slot < 0) request(key);
+    }
+
+    // Queues the response of a pluck under the current parameters without
+    // playing it, e.g. for every pluck of a patch when it loads
+    void prepare(int stringIndex, float position) {
+        position = std::max(0.1f, std::min(0.9f, position));
+        PluckKey key = keyFor(stringIndex, position);
+        if (findSlot(key) < 0) request(key);
+    }
+
+    // Live engine plus every sounding voice. The pickup is part of the key:
+    // plucks after a pickup change use (or record) responses for the new one.
+    void renderBlock(int numFrames, float pickupPos, float* outL, float* outR) {
+        params.pickup = std::max(0.0f, std::min(1.0f, pickupPos));
+        live.renderBlock(numFrames, params.pickup, outL, outR);
+
+        for (Voice& v : voices) {
+            if (v.slot < 0) continue;
+
+            const Slot& s = slots[v.slot];
+            int frames = std::min(numFrames, s.frames - v.frame);
+            const float* src = s.response.data() + 2 * static_cast<size_t>(v.frame);
+            for (int i = 0; i < frames; i++) {
+                outL[i] += v.gain * src[2 * i];
+                outR[i] += v.gain * src[2 * i + 1];
+            }
+
+            v.frame += frames;
+            if (v.frame >= s.frames) v.slot = -1;
+        }
+    }
+
+    void reset() {
+        live.reset();
+        for (Voice& v : voices) v.slot = -1;
+    }
+
+    // ========================================================================
+    // Background computation (one thread other than the audio thread, or the
+    // audio thread itself between callbacks)
+    // ========================================================================
+    // Records up to maxFrames of the pending responses; returns the frames
+    // recorded, 0 when nothing is pending
+    int computePending(int maxFrames) {
+        int done = 0;
+        while (done < maxFrames) {
+            if (building < 0 && !startBuilding()) break;
+
+            Slot& s = slots[building];
+            int chunk = std::min({RESPONSE_CHUNK, maxFrames - done, maxResponseFrames() - s.frames});
+            s.response.resize(2 * static_cast<size_t>(s.frames + chunk));
+            builder.renderBlock(chunk, s.key.pickup, chunkL.data(), chunkR.data());
+
+            float* dst = s.response.data() + 2 * static_cast<size_t>(s.frames);
+            for (int i = 0; i < chunk; i++) {
+                dst[2 * i] = chunkL[i];
+                dst[2 * i + 1] = chunkR[i];
+            }
+            s.frames += chunk;
+            done += chunk;
+
+            bool silent = builder.getString1Asleep() && builder.getString2Asleep();
+            if (silent || s.frames >= maxResponseFrames()) {
+                if (!silent) fadeOut(s);
+                s.state.store(READY, std::memory_order_release);
+                building = -1;
+            }
+        }
+        return done;
+    }
+
+    // ========================================================================
+    // Diagnostics
+    // ========================================================================
+    bool isCached(int stringIndex, float position) const {
+        position = std::max(0.1f, std::min(0.9f, position));
+        int slot = findSlot(keyFor(stringIndex, position));
+        return slot >= 0 && slots[slot].state.load(std::memory_order_acquire) == READY;
+    }
+
+    int getCachedCount() const {
+        int count = 0;
+        for (const Slot& s : slots) count += s.state.load(std::memory_order_acquire) == READY;
+        return count;
+    }
+
+    int getActiveVoices() const {
+        int count = 0;
+        for (const Voice& v : voices) count += v.slot >= 0;
+        return count;
+    }
+
+private:
+    enum SlotState { EMPTY, PENDING, BUILDING, READY };
+
+    struct Slot {
+        std::atomic<int> state{EMPTY};
+        PluckKey key;                  // Written by the audio thread while EMPTY
+        std::vector<float> response;   // Interleaved L/R, written while BUILDING
+        int frames = 0;
+        unsigned lastUsed = 0;         // Audio thread only
+    };
+
+    struct Voice {
+        int slot = -1;
+        int frame = 0;
+        float gain = 0.0f;
+    };
+
+    PluckKey params;  // Current parameters (stringIndex / position unused)
+    Slot slots[PLUCK_CACHE_SLOTS];
+    Voice voices[PLUCK_CACHE_VOICES];
+    unsigned useClock = 0;
+
+    // Background side
+    SympatheticStrings builder;
+    int building = -1;
+    std::array<float, RESPONSE_CHUNK> chunkL;
+    std::array<float, RESPONSE_CHUNK> chunkR;
+
+    static int maxResponseFrames() { return static_cast<int>(RESPONSE_SECONDS * SAMPLE_RATE); }
+
+    PluckKey keyFor(int stringIndex, float position) const {
+        PluckKey key = params;
+        key.stringIndex = stringIndex == 0 ? 0 : 1;
+        key.position = position;
+        return key;
+    }
+
+    // Slot holding (or about to hold) key, or -1
+    int findSlot(const PluckKey& key) const {
+        for (int i = 0; i < PLUCK_CACHE_SLOTS; i++) {
+            if (slots[i].state.load(std::memory_order_acquire) != EMPTY && slots[i].key == key) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    bool playing(int slot) const {
+        for (const Voice& v : voices) {
+            if (v.slot == slot) return true;
+        }
+        return false;
+    }
+
+    // Claims an empty slot, or the least recently used ready one that is not
+    // playing, and hands it to the background. Nothing free: the live engine
+    // keeps covering this configuration.
+    void request(const PluckKey& key) {
+        int target = -1;
+        for (int i = 0; i < PLUCK_CACHE_SLOTS && target < 0; i++) {
+            if (slots[i].state.load(std::memory_order_acquire) == EMPTY) target = i;
+        }
+        for (int i = 0; i < PLUCK_CACHE_SLOTS && target < 0; i++) {
+            if (slots[i].state.load(std::memory_order_acquire) != READY || playing(i)) continue;
+            if (target < 0 || slots[i].lastUsed < slots[target].lastUsed) target = i;
+        }
+        if (target < 0) return;
+
+        slots[target].key = key;
+        slots[target].lastUsed = ++useClock;
+        slots[target].state.store(PENDING, std::memory_order_release);
+    }
+
+    // Takes a free voice, or the one that has sounded longest
+    void startVoice(int slot, float amplitude) {
+        Voice* voice = &voices[0];
+        for (Voice& v : voices) {
+            if (v.slot < 0) {
+                voice = &v;
+                break;
+            }
+            if (v.frame > voice->frame) voice = &v;
+        }
+        voice->slot = slot;
+        voice->frame = 0;
+        voice->gain = amplitude;
+        slots[slot].lastUsed = ++useClock;
+    }
+
+    // Sets up the builder for the next pending slot
+    bool startBuilding() {
+        for (int i = 0; i < PLUCK_CACHE_SLOTS; i++) {
+            int expected = PENDING;
+            if (!slots[i].state.compare_exchange_strong(expected, BUILDING,
+                                                        std::memory_order_acquire)) {
+                continue;
+            }
+
+            const PluckKey& key = slots[i].key;
+            builder.reset();
+            builder.setString1Frequency(key.f1);
+            builder.setString2Frequency(key.f2);
+            builder.setBridgeStiffness(key.stiffness);
+            builder.setDamping(key.damping);
+            builder.setImplicit(key.implicit);
+            builder.pluck(key.stringIndex, key.position, 1.0f);
+
+            slots[i].frames = 0;
+            slots[i].response.clear();
+            building = i;
+            return true;
+        }
+        return false;
+    }
+
+    static void fadeOut(Slot& s) {
+        int fade = std::min(RESPONSE_FADE, s.frames);
+        for (int i = 0; i < fade; i++) {
+            float g = static_cast<float>(i) / fade;
+            size_t frame = static_cast<size_t>(s.frames - 1 - i);
+            s.response[2 * frame] *= g;
+            s.response[2 * frame + 1] *= g;
+        }
+    }
+};
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+
+// Native background thread for a PluckCache: records pending responses and
+// naps while there are none
+class PluckCacheWorker {
+public:
+    explicit PluckCacheWorker(PluckCache& cache) : cache(cache), thread([this] { run(); }) {}
+
+    ~PluckCacheWorker() {
+        stop.store(true, std::memory_order_relaxed);
+        thread.join();
+    }
+
+private:
+    PluckCache& cache;
+    std::atomic<bool> stop{false};
+    std::thread thread;
+
+    void run() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (cache.computePending(4096) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,156 @@
+/**
+ * SPSC Ring - lock-free single-producer / single-consumer queues
+ *
+ * Two free-running 32-bit counters, each written by one side only:
+ *
+ *   storage:  [ . . . r r r r r . . . ]     r = readable frames
+ *                     ^readPos  ^writePos    (counters taken mod capacity)
+ *
+ * The producer fills frames and then publishes them with a release store of
+ * `writePos`. The consumer copies them out and frees them with a release store
+ * of `readPos`. Capacity is a power of two, so the counters may wrap at 2^32
+ * and `writePos - readPos` is still the fill level. Nobody locks, waits or
+ * allocates, which makes both sides safe on an audio thread.
+ *
+ * AudioRing keeps planar stereo floats. Another thread may ask for the
+ * ring to be emptied: it bumps `flushRequest`, and the consumer drops
+ * everything up to `writePos` at its next read and echoes the request into
+ * `flushDone`. `readPos` stays the consumer's alone, so a flush can never
+ * race a read and move it backwards. The counters are plain 32-bit words in
+ * memory, so in the pthreads browser build JavaScript can be the consumer
+ * and read them with Atomics on the shared heap (see web/index.html).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <algorithm>
+
+// Fixed-capacity queue of trivially copyable items (commands, events)
+template <typename T, int Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer: false when full
+    bool push(const T& item) {
+        uint32_t w = writePos.load(std::memory_order_relaxed);
+        if (w - readPos.load(std::memory_order_acquire) >= Capacity) return false;
+        items[w & (Capacity - 1)] = item;
+        writePos.store(w + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: false when empty
+    bool pop(T& item) {
+        uint32_t r = readPos.load(std::memory_order_relaxed);
+        if (r == writePos.load(std::memory_order_acquire)) return false;
+        item = items[r & (Capacity - 1)];
+        readPos.store(r + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> items;
+    alignas(64) std::atomic<uint32_t> writePos{0};
+    alignas(64) std::atomic<uint32_t> readPos{0};
+};
+
+template <int Capacity>
+class AudioRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(sizeof(std::atomic<uint32_t>) == 4, "counters must be plain 32-bit words");
+
+public:
+    static constexpr int capacity() { return Capacity; }
+
+    // ------------------------------------------------------------------------
+    // Producer side
+    // ------------------------------------------------------------------------
+    // Frames the producer may still write
+    int space() const {
+        return Capacity - static_cast<int>(writePos.load(std::memory_order_relaxed)
+                                           - readPos.load(std::memory_order_acquire));
+    }
+
+    // Appends numFrames (<= space()) and publishes them
+    void write(const float* inL, const float* inR, int numFrames) {
+        uint32_t w = writePos.load(std::memory_order_relaxed);
+        copyIn(left.data(), inL, w, numFrames);
+        copyIn(right.data(), inR, w, numFrames);
+        writePos.store(w + numFrames, std::memory_order_release);
+    }
+
+    // ------------------------------------------------------------------------
+    // Consumer side
+    // ------------------------------------------------------------------------
+    // Frames ready to read
+    int available() const {
+        return static_cast<int>(writePos.load(std::memory_order_acquire)
+                                - readPos.load(std::memory_order_relaxed));
+    }
+
+    // Copies up to numFrames out and zero-fills the rest (underrun); returns
+    // the frames that were read
+    int read(float* outL, float* outR, int numFrames) {
+        takeFlush();
+        uint32_t r = readPos.load(std::memory_order_relaxed);
+        int n = std::min(numFrames, available());
+        copyOut(outL, left.data(), r, n);
+        copyOut(outR, right.data(), r, n);
+        std::fill(outL + n, outL + numFrames, 0.0f);
+        std::fill(outR + n, outR + numFrames, 0.0f);
+        readPos.store(r + n, std::memory_order_release);
+        return n;
+    }
+
+    // ------------------------------------------------------------------------
+    // Any one other thread
+    // ------------------------------------------------------------------------
+    // Asks the consumer to drop everything written so far (stale audio after
+    // a pause); takes effect at its next read
+    void requestFlush() {
+        uint32_t request = flushRequest.load(std::memory_order_relaxed);
+        flushRequest.store(request + 1, std::memory_order_release);
+    }
+
+    // Memory layout, for consumers outside C++
+    const float* leftData() const { return left.data(); }
+    const float* rightData() const { return right.data(); }
+    const void* writeCounter() const { return &writePos; }
+    const void* readCounter() const { return &readPos; }
+    const void* flushRequestCounter() const { return &flushRequest; }
+    const void* flushDoneCounter() const { return &flushDone; }
+
+private:
+    alignas(64) std::array<float, Capacity> left;
+    alignas(64) std::array<float, Capacity> right;
+    alignas(64) std::atomic<uint32_t> writePos{0};
+    alignas(64) std::atomic<uint32_t> readPos{0};
+    std::atomic<uint32_t> flushDone{0};            // Consumer
+    alignas(64) std::atomic<uint32_t> flushRequest{0};
+
+    // Consumer: honours a pending flush request
+    void takeFlush() {
+        uint32_t request = flushRequest.load(std::memory_order_acquire);
+        if (request == flushDone.load(std::memory_order_relaxed)) return;
+        readPos.store(writePos.load(std::memory_order_acquire), std::memory_order_release);
+        flushDone.store(request, std::memory_order_relaxed);
+    }
+
+    static void copyIn(float* ring, const float* src, uint32_t at, int n) {
+        int start = static_cast<int>(at & (Capacity - 1));
+        int first = std::min(n, Capacity - start);
+        std::copy(src, src + first, ring + start);
+        std::copy(src + first, src + n, ring);
+    }
+
+    static void copyOut(float* dst, const float* ring, uint32_t at, int n) {
+        int start = static_cast<int>(at & (Capacity - 1));
+        int first = std::min(n, Capacity - start);
+        std::copy(ring + start, ring + start + first, dst);
+        std::copy(ring, ring + n - first, dst + first);
+    }
+};
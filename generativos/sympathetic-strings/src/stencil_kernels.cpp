@@ -0,0 +1,44 @@
+/**
+ * Stencil Kernels - native runtime dispatch
+ *
+ * Only compiled into native x86-64 builds (see sympathetic-native/build.sh).
+ * The WebAssembly builds pick their table at compile time in the header.
+ */
+
+#include "stencil_kernels.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+const StencilKernels* findStencilKernels(const char* name) {
+    // __builtin_cpu_supports reads cpuid (and the OS-enabled XSAVE state)
+    __builtin_cpu_init();
+
+    if (std::strcmp(name, "scalar") == 0) {
+        return &SCALAR_STENCIL_KERNELS;
+    }
+    if (std::strcmp(name, "avx2") == 0) {
+        return __builtin_cpu_supports("avx2") ? &AVX2_STENCIL_KERNELS : nullptr;
+    }
+    if (std::strcmp(name, "avx512") == 0) {
+        return __builtin_cpu_supports("avx512f") ? &AVX512_STENCIL_KERNELS : nullptr;
+    }
+    return nullptr;
+}
+
+static const StencilKernels& selectStencilKernels() {
+    if (const char* forced = std::getenv("SYMPATHETIC_KERNELS")) {
+        if (const StencilKernels* kernels = findStencilKernels(forced)) return *kernels;
+    }
+
+    for (const char* name : {"avx512", "avx2"}) {
+        if (const StencilKernels* kernels = findStencilKernels(name)) return *kernels;
+    }
+    return SCALAR_STENCIL_KERNELS;
+}
+
+const StencilKernels& activeStencilKernels() {
+    static const StencilKernels& kernels = selectStencilKernels();
+    return kernels;
+}
@@ -0,0 +1,332 @@
+/**
+ * Stencil Kernels - inner loops of the string FDTD scheme
+ *
+ * Three loops dominate the cost of a physics step:
+ *   - interior: Laplacian + damping + leapfrog update over points [1, n-2]
+ *   - commit:   velocity and time-level shift over all n points
+ *   - energy:   kinetic + potential energy sums
+ *
+ * plus batchInterior, the interior update of many independent strings
+ * stored lane-interleaved (batch_strings.h): point i of lane l sits at
+ * [i * lanes + l], so a vector holds the same point of neighbouring lanes
+ * and each lane brings its own Courant number and damping. Commit needs no
+ * batch version, it is elementwise.
+ *
+ * Each one has a scalar reference plus vector versions, grouped into a
+ * StencilKernels table that the engines call through:
+ *   - simd128: WebAssembly SIMD, when compiled with -msimd128
+ *   - avx2 / avx512: native x86-64 builds (stencil_kernels_avx2.cpp,
+ *     stencil_kernels_avx512.cpp), picked at startup from cpuid
+ * Double-precision engines only have the scalar loops (stencilKernelsFor).
+ *
+ * The vector interior and commit loops evaluate exactly the same expressions
+ * in the same order as the scalar ones (no FMA), so results are
+ * bit-identical. The energy sums are reassociated across lanes and can differ
+ * from the scalar sum in the last bits.
+ */
+
+#pragma once
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__EMSCRIPTEN__)
+#define STENCIL_NATIVE_DISPATCH 1
+#else
+#define STENCIL_NATIVE_DISPATCH 0
+#endif
+
+// Table over the engine's real type; the vector versions are float only
+template <typename Real>
+struct BasicStencilKernels {
+    const char* name;
+
+    // Leapfrog update of points [1, n-2] into yNew
+    void (*interior)(const Real* y, const Real* yPrev, Real* yNew, int n,
+                     Real rSq, Real damping, Real dt);
+
+    // v = (yNew - y) / dt, then shift yNew -> y -> yPrev over all n points
+    void (*commit)(Real* y, Real* yPrev, Real* v, const Real* yNew, int n, Real dt);
+
+    // Kinetic and potential energy of one string
+    void (*energy)(const Real* y, const Real* v, int n, Real density, Real tension,
+                   Real dx, Real& ke, Real& pe);
+
+    // interior for `lanes` interleaved strings of n points, lane l with
+    // rSq[l] and damping[l]; lanes is a power of two up to BATCH_MAX_LANES
+    void (*batchInterior)(const Real* y, const Real* yPrev, Real* yNew, int n, int lanes,
+                          const Real* rSq, const Real* damping, Real dt);
+};
+
+using StencilKernels = BasicStencilKernels<float>;
+
+constexpr int BATCH_MAX_LANES = 16;
+
+// Per-lane coefficients laid out for vector loads: for a vector starting at
+// flattened index j, the coefficients of its lanes are tile[j % period ..],
+// period = max(lanes, width). The tile holds two periods so the load never
+// runs off the end when lanes < width.
+struct BatchTile {
+    alignas(64) float rSq[4 * BATCH_MAX_LANES];
+    alignas(64) float dampDt[4 * BATCH_MAX_LANES];
+    int period;
+
+    BatchTile(int lanes, int width, const float* r, const float* damping, float dt) {
+        period = lanes > width ? lanes : width;
+        for (int k = 0; k < 2 * period; k++) {
+            rSq[k] = r[k % lanes];
+            dampDt[k] = damping[k % lanes] * dt;
+        }
+    }
+};
+
+// ============================================================================
+// Scalar reference
+// ============================================================================
+template <typename Real>
+inline void stencilInteriorScalar(const Real* y, const Real* yPrev, Real* yNew, int n,
+                                  Real rSq, Real damping, Real dt) {
+    for (int i = 1; i < n - 1; i++) {
+        Real lap = y[i+1] - 2.0f * y[i] + y[i-1];
+        Real vel = (y[i] - yPrev[i]) / dt;
+        yNew[i] = 2.0f * y[i] - yPrev[i] + rSq * lap - damping * dt * vel;
+    }
+}
+
+template <typename Real>
+inline void stencilCommitScalar(Real* y, Real* yPrev, Real* v, const Real* yNew, int n,
+                                Real dt) {
+    for (int i = 0; i < n; i++) {
+        v[i] = (yNew[i] - y[i]) / dt;
+        yPrev[i] = y[i];
+        y[i] = yNew[i];
+    }
+}
+
+template <typename Real>
+inline void stringEnergyScalar(const Real* y, const Real* v, int n, Real density,
+                               Real tension, Real dx, Real& ke, Real& pe) {
+    ke = 0.0f;
+    pe = 0.0f;
+    for (int i = 0; i < n; i++) {
+        ke += 0.5f * density * dx * v[i] * v[i];
+
+        if (i < n - 1) {
+            Real strain = (y[i+1] - y[i]) / dx;
+            pe += 0.5f * tension * strain * strain * dx;
+        }
+    }
+}
+
+template <typename Real>
+inline void batchInteriorScalar(const Real* y, const Real* yPrev, Real* yNew, int n, int lanes,
+                                const Real* rSq, const Real* damping, Real dt) {
+    for (int i = 1; i < n - 1; i++) {
+        for (int l = 0; l < lanes; l++) {
+            int j = i * lanes + l;
+            Real lap = y[j+lanes] - 2.0f * y[j] + y[j-lanes];
+            Real vel = (y[j] - yPrev[j]) / dt;
+            yNew[j] = 2.0f * y[j] - yPrev[j] + rSq[l] * lap - damping[l] * dt * vel;
+        }
+    }
+}
+
+// Scalar tail of a vector batch loop: flattened indices [j, end)
+inline void batchInteriorTail(const float* y, const float* yPrev, float* yNew, int j, int end,
+                              int lanes, const float* rSq, const float* damping, float dt) {
+    for (; j < end; j++) {
+        int l = j & (lanes - 1);
+        float lap = y[j+lanes] - 2.0f * y[j] + y[j-lanes];
+        float vel = (y[j] - yPrev[j]) / dt;
+        yNew[j] = 2.0f * y[j] - yPrev[j] + rSq[l] * lap - damping[l] * dt * vel;
+    }
+}
+
+// ============================================================================
+// WebAssembly SIMD128
+// ============================================================================
+#ifdef __wasm_simd128__
+
+inline void stencilInteriorSimd(const float* y, const float* yPrev, float* yNew, int n,
+                                float rSq, float damping, float dt) {
+    const v128_t two = wasm_f32x4_splat(2.0f);
+    const v128_t r = wasm_f32x4_splat(rSq);
+    const v128_t dampDt = wasm_f32x4_splat(damping * dt);
+    const v128_t step = wasm_f32x4_splat(dt);
+
+    int i = 1;
+    for (; i + 4 <= n - 1; i += 4) {
+        v128_t yc = wasm_v128_load(y + i);
+        v128_t yl = wasm_v128_load(y + i - 1);
+        v128_t yr = wasm_v128_load(y + i + 1);
+        v128_t yp = wasm_v128_load(yPrev + i);
+
+        v128_t twoY = wasm_f32x4_mul(two, yc);
+        v128_t lap = wasm_f32x4_add(wasm_f32x4_sub(yr, twoY), yl);
+        v128_t vel = wasm_f32x4_div(wasm_f32x4_sub(yc, yp), step);
+
+        v128_t out = wasm_f32x4_add(wasm_f32x4_sub(twoY, yp), wasm_f32x4_mul(r, lap));
+        out = wasm_f32x4_sub(out, wasm_f32x4_mul(dampDt, vel));
+        wasm_v128_store(yNew + i, out);
+    }
+
+    // Remainder
+    for (; i < n - 1; i++) {
+        float lap = y[i+1] - 2.0f * y[i] + y[i-1];
+        float vel = (y[i] - yPrev[i]) / dt;
+        yNew[i] = 2.0f * y[i] - yPrev[i] + rSq * lap - damping * dt * vel;
+    }
+}
+
+inline void batchInteriorSimd(const float* y, const float* yPrev, float* yNew, int n, int lanes,
+                              const float* rSq, const float* damping, float dt) {
+    const BatchTile tile(lanes, 4, rSq, damping, dt);
+    const v128_t two = wasm_f32x4_splat(2.0f);
+    const v128_t step = wasm_f32x4_splat(dt);
+    const int end = (n - 1) * lanes;
+
+    int j = lanes;
+    for (; j + 4 <= end; j += 4) {
+        int k = j & (tile.period - 1);
+        v128_t yc = wasm_v128_load(y + j);
+        v128_t yl = wasm_v128_load(y + j - lanes);
+        v128_t yr = wasm_v128_load(y + j + lanes);
+        v128_t yp = wasm_v128_load(yPrev + j);
+
+        v128_t twoY = wasm_f32x4_mul(two, yc);
+        v128_t lap = wasm_f32x4_add(wasm_f32x4_sub(yr, twoY), yl);
+        v128_t vel = wasm_f32x4_div(wasm_f32x4_sub(yc, yp), step);
+
+        v128_t out = wasm_f32x4_add(wasm_f32x4_sub(twoY, yp),
+                                    wasm_f32x4_mul(wasm_v128_load(tile.rSq + k), lap));
+        out = wasm_f32x4_sub(out, wasm_f32x4_mul(wasm_v128_load(tile.dampDt + k), vel));
+        wasm_v128_store(yNew + j, out);
+    }
+
+    batchInteriorTail(y, yPrev, yNew, j, end, lanes, rSq, damping, dt);
+}
+
+inline void stencilCommitSimd(float* y, float* yPrev, float* v, const float* yNew, int n,
+                              float dt) {
+    const v128_t step = wasm_f32x4_splat(dt);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t yc = wasm_v128_load(y + i);
+        v128_t yn = wasm_v128_load(yNew + i);
+        wasm_v128_store(v + i, wasm_f32x4_div(wasm_f32x4_sub(yn, yc), step));
+        wasm_v128_store(yPrev + i, yc);
+        wasm_v128_store(y + i, yn);
+    }
+
+    for (; i < n; i++) {
+        v[i] = (yNew[i] - y[i]) / dt;
+        yPrev[i] = y[i];
+        y[i] = yNew[i];
+    }
+}
+
+inline void stringEnergySimd(const float* y, const float* v, int n, float density,
+                             float tension, float dx, float& ke, float& pe) {
+    const v128_t keScale = wasm_f32x4_splat(0.5f * density * dx);
+    const v128_t peScale = wasm_f32x4_splat(0.5f * tension);
+    const v128_t vdx = wasm_f32x4_splat(dx);
+    v128_t keAcc = wasm_f32x4_splat(0.0f);
+    v128_t peAcc = wasm_f32x4_splat(0.0f);
+
+    // Kinetic: all n points
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t vi = wasm_v128_load(v + i);
+        keAcc = wasm_f32x4_add(keAcc, wasm_f32x4_mul(wasm_f32x4_mul(keScale, vi), vi));
+    }
+    float keTail = 0.0f;
+    for (; i < n; i++) keTail += 0.5f * density * dx * v[i] * v[i];
+
+    // Potential: n - 1 segments
+    i = 0;
+    for (; i + 4 <= n - 1; i += 4) {
+        v128_t strain = wasm_f32x4_div(
+            wasm_f32x4_sub(wasm_v128_load(y + i + 1), wasm_v128_load(y + i)), vdx);
+        v128_t term = wasm_f32x4_mul(wasm_f32x4_mul(wasm_f32x4_mul(peScale, strain), strain), vdx);
+        peAcc = wasm_f32x4_add(peAcc, term);
+    }
+    float peTail = 0.0f;
+    for (; i < n - 1; i++) {
+        float strain = (y[i+1] - y[i]) / dx;
+        peTail += 0.5f * tension * strain * strain * dx;
+    }
+
+    ke = wasm_f32x4_extract_lane(keAcc, 0) + wasm_f32x4_extract_lane(keAcc, 1)
+       + wasm_f32x4_extract_lane(keAcc, 2) + wasm_f32x4_extract_lane(keAcc, 3) + keTail;
+    pe = wasm_f32x4_extract_lane(peAcc, 0) + wasm_f32x4_extract_lane(peAcc, 1)
+       + wasm_f32x4_extract_lane(peAcc, 2) + wasm_f32x4_extract_lane(peAcc, 3) + peTail;
+}
+
+#endif
+
+// ============================================================================
+// Kernel tables
+// ============================================================================
+inline constexpr StencilKernels SCALAR_STENCIL_KERNELS = {
+    "scalar", stencilInteriorScalar<float>, stencilCommitScalar<float>, stringEnergyScalar<float>,
+    batchInteriorScalar<float>
+};
+
+// Double-precision engines run the scalar loops, which the compiler
+// vectorizes on its own
+inline constexpr BasicStencilKernels<double> SCALAR_STENCIL_KERNELS_DOUBLE = {
+    "scalar", stencilInteriorScalar<double>, stencilCommitScalar<double>,
+    stringEnergyScalar<double>, batchInteriorScalar<double>
+};
+
+#ifdef __wasm_simd128__
+inline constexpr StencilKernels SIMD128_STENCIL_KERNELS = {
+    "simd128", stencilInteriorSimd, stencilCommitSimd, stringEnergySimd, batchInteriorSimd
+};
+#endif
+
+#if STENCIL_NATIVE_DISPATCH
+
+extern const StencilKernels AVX2_STENCIL_KERNELS;    // stencil_kernels_avx2.cpp
+extern const StencilKernels AVX512_STENCIL_KERNELS;  // stencil_kernels_avx512.cpp
+
+// Best table this CPU supports, chosen once from cpuid. The environment
+// variable SYMPATHETIC_KERNELS=scalar|avx2|avx512 overrides the choice.
+const StencilKernels& activeStencilKernels();
+
+// Table by name, or nullptr when unknown or unsupported on this CPU
+const StencilKernels* findStencilKernels(const char* name);
+
+#else
+
+inline const StencilKernels& activeStencilKernels() {
+#ifdef __wasm_simd128__
+    return SIMD128_STENCIL_KERNELS;
+#else
+    return SCALAR_STENCIL_KERNELS;
+#endif
+}
+
+inline const StencilKernels* findStencilKernels(const char* name) {
+    const StencilKernels& active = activeStencilKernels();
+    if (__builtin_strcmp(name, active.name) == 0) return &active;
+    if (__builtin_strcmp(name, "scalar") == 0) return &SCALAR_STENCIL_KERNELS;
+    return nullptr;
+}
+
+#endif
+
+// Kernels for an engine over Real: the dispatched table for float, the scalar
+// reference for double
+template <typename Real>
+const BasicStencilKernels<Real>& stencilKernelsFor();
+
+template <>
+inline const StencilKernels& stencilKernelsFor<float>() { return activeStencilKernels(); }
+
+template <>
+inline const BasicStencilKernels<double>& stencilKernelsFor<double>() {
+    return SCALAR_STENCIL_KERNELS_DOUBLE;
+}
@@ -0,0 +1,136 @@
+/**
+ * Stencil Kernels - AVX2 (8 points per instruction)
+ *
+ * Compiled with -mavx2 and called only after cpuid reports AVX2 support.
+ * Same operations, in the same order, as the scalar reference.
+ */
+
+#include "stencil_kernels.h"
+
+#include <immintrin.h>
+
+static inline float horizontalSum(__m256 v) {
+    __m128 lo = _mm256_castps256_ps128(v);
+    __m128 hi = _mm256_extractf128_ps(v, 1);
+    __m128 sum = _mm_add_ps(lo, hi);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+static void stencilInteriorAvx2(const float* y, const float* yPrev, float* yNew, int n,
+                                float rSq, float damping, float dt) {
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 r = _mm256_set1_ps(rSq);
+    const __m256 dampDt = _mm256_set1_ps(damping * dt);
+    const __m256 step = _mm256_set1_ps(dt);
+
+    int i = 1;
+    for (; i + 8 <= n - 1; i += 8) {
+        __m256 yc = _mm256_loadu_ps(y + i);
+        __m256 yl = _mm256_loadu_ps(y + i - 1);
+        __m256 yr = _mm256_loadu_ps(y + i + 1);
+        __m256 yp = _mm256_loadu_ps(yPrev + i);
+
+        __m256 twoY = _mm256_mul_ps(two, yc);
+        __m256 lap = _mm256_add_ps(_mm256_sub_ps(yr, twoY), yl);
+        __m256 vel = _mm256_div_ps(_mm256_sub_ps(yc, yp), step);
+
+        __m256 out = _mm256_add_ps(_mm256_sub_ps(twoY, yp), _mm256_mul_ps(r, lap));
+        out = _mm256_sub_ps(out, _mm256_mul_ps(dampDt, vel));
+        _mm256_storeu_ps(yNew + i, out);
+    }
+
+    for (; i < n - 1; i++) {
+        float lap = y[i+1] - 2.0f * y[i] + y[i-1];
+        float vel = (y[i] - yPrev[i]) / dt;
+        yNew[i] = 2.0f * y[i] - yPrev[i] + rSq * lap - damping * dt * vel;
+    }
+}
+
+static void batchInteriorAvx2(const float* y, const float* yPrev, float* yNew, int n, int lanes,
+                              const float* rSq, const float* damping, float dt) {
+    const BatchTile tile(lanes, 8, rSq, damping, dt);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 step = _mm256_set1_ps(dt);
+    const int end = (n - 1) * lanes;
+
+    int j = lanes;
+    for (; j + 8 <= end; j += 8) {
+        int k = j & (tile.period - 1);
+        __m256 yc = _mm256_loadu_ps(y + j);
+        __m256 yl = _mm256_loadu_ps(y + j - lanes);
+        __m256 yr = _mm256_loadu_ps(y + j + lanes);
+        __m256 yp = _mm256_loadu_ps(yPrev + j);
+
+        __m256 twoY = _mm256_mul_ps(two, yc);
+        __m256 lap = _mm256_add_ps(_mm256_sub_ps(yr, twoY), yl);
+        __m256 vel = _mm256_div_ps(_mm256_sub_ps(yc, yp), step);
+
+        __m256 out = _mm256_add_ps(_mm256_sub_ps(twoY, yp),
+                                   _mm256_mul_ps(_mm256_loadu_ps(tile.rSq + k), lap));
+        out = _mm256_sub_ps(out, _mm256_mul_ps(_mm256_loadu_ps(tile.dampDt + k), vel));
+        _mm256_storeu_ps(yNew + j, out);
+    }
+
+    batchInteriorTail(y, yPrev, yNew, j, end, lanes, rSq, damping, dt);
+}
+
+static void stencilCommitAvx2(float* y, float* yPrev, float* v, const float* yNew, int n,
+                              float dt) {
+    const __m256 step = _mm256_set1_ps(dt);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 yc = _mm256_loadu_ps(y + i);
+        __m256 yn = _mm256_loadu_ps(yNew + i);
+        _mm256_storeu_ps(v + i, _mm256_div_ps(_mm256_sub_ps(yn, yc), step));
+        _mm256_storeu_ps(yPrev + i, yc);
+        _mm256_storeu_ps(y + i, yn);
+    }
+
+    for (; i < n; i++) {
+        v[i] = (yNew[i] - y[i]) / dt;
+        yPrev[i] = y[i];
+        y[i] = yNew[i];
+    }
+}
+
+static void stringEnergyAvx2(const float* y, const float* v, int n, float density,
+                             float tension, float dx, float& ke, float& pe) {
+    const __m256 keScale = _mm256_set1_ps(0.5f * density * dx);
+    const __m256 peScale = _mm256_set1_ps(0.5f * tension);
+    const __m256 vdx = _mm256_set1_ps(dx);
+    __m256 keAcc = _mm256_setzero_ps();
+    __m256 peAcc = _mm256_setzero_ps();
+
+    // Kinetic: all n points
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 vi = _mm256_loadu_ps(v + i);
+        keAcc = _mm256_add_ps(keAcc, _mm256_mul_ps(_mm256_mul_ps(keScale, vi), vi));
+    }
+    float keTail = 0.0f;
+    for (; i < n; i++) keTail += 0.5f * density * dx * v[i] * v[i];
+
+    // Potential: n - 1 segments
+    i = 0;
+    for (; i + 8 <= n - 1; i += 8) {
+        __m256 strain = _mm256_div_ps(
+            _mm256_sub_ps(_mm256_loadu_ps(y + i + 1), _mm256_loadu_ps(y + i)), vdx);
+        __m256 term = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(peScale, strain), strain), vdx);
+        peAcc = _mm256_add_ps(peAcc, term);
+    }
+    float peTail = 0.0f;
+    for (; i < n - 1; i++) {
+        float strain = (y[i+1] - y[i]) / dx;
+        peTail += 0.5f * tension * strain * strain * dx;
+    }
+
+    ke = horizontalSum(keAcc) + keTail;
+    pe = horizontalSum(peAcc) + peTail;
+}
+
+const StencilKernels AVX2_STENCIL_KERNELS = {
+    "avx2", stencilInteriorAvx2, stencilCommitAvx2, stringEnergyAvx2, batchInteriorAvx2
+};
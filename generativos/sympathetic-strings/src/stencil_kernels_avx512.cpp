@@ -0,0 +1,116 @@
+/**
+ * Stencil Kernels - AVX-512 (16 points per instruction)
+ *
+ * Compiled with -mavx512f and called only after cpuid reports AVX-512F
+ * support. Tails use masked loads/stores instead of a scalar remainder.
+ * Same operations, in the same order, as the scalar reference.
+ */
+
+#include "stencil_kernels.h"
+
+#include <immintrin.h>
+
+static inline __mmask16 tailMask(int count) {
+    return static_cast<__mmask16>((1u << count) - 1u);
+}
+
+static void stencilInteriorAvx512(const float* y, const float* yPrev, float* yNew, int n,
+                                  float rSq, float damping, float dt) {
+    const __m512 two = _mm512_set1_ps(2.0f);
+    const __m512 r = _mm512_set1_ps(rSq);
+    const __m512 dampDt = _mm512_set1_ps(damping * dt);
+    const __m512 step = _mm512_set1_ps(dt);
+
+    for (int i = 1; i < n - 1; i += 16) {
+        __mmask16 m = (n - 1 - i >= 16) ? __mmask16(0xFFFF) : tailMask(n - 1 - i);
+
+        __m512 yc = _mm512_maskz_loadu_ps(m, y + i);
+        __m512 yl = _mm512_maskz_loadu_ps(m, y + i - 1);
+        __m512 yr = _mm512_maskz_loadu_ps(m, y + i + 1);
+        __m512 yp = _mm512_maskz_loadu_ps(m, yPrev + i);
+
+        __m512 twoY = _mm512_mul_ps(two, yc);
+        __m512 lap = _mm512_add_ps(_mm512_sub_ps(yr, twoY), yl);
+        __m512 vel = _mm512_div_ps(_mm512_sub_ps(yc, yp), step);
+
+        __m512 out = _mm512_add_ps(_mm512_sub_ps(twoY, yp), _mm512_mul_ps(r, lap));
+        out = _mm512_sub_ps(out, _mm512_mul_ps(dampDt, vel));
+        _mm512_mask_storeu_ps(yNew + i, m, out);
+    }
+}
+
+static void batchInteriorAvx512(const float* y, const float* yPrev, float* yNew, int n,
+                                int lanes, const float* rSq, const float* damping, float dt) {
+    const BatchTile tile(lanes, 16, rSq, damping, dt);
+    const __m512 two = _mm512_set1_ps(2.0f);
+    const __m512 step = _mm512_set1_ps(dt);
+    const int end = (n - 1) * lanes;
+
+    for (int j = lanes; j < end; j += 16) {
+        __mmask16 m = (end - j >= 16) ? __mmask16(0xFFFF) : tailMask(end - j);
+        int k = j & (tile.period - 1);
+
+        __m512 yc = _mm512_maskz_loadu_ps(m, y + j);
+        __m512 yl = _mm512_maskz_loadu_ps(m, y + j - lanes);
+        __m512 yr = _mm512_maskz_loadu_ps(m, y + j + lanes);
+        __m512 yp = _mm512_maskz_loadu_ps(m, yPrev + j);
+
+        __m512 twoY = _mm512_mul_ps(two, yc);
+        __m512 lap = _mm512_add_ps(_mm512_sub_ps(yr, twoY), yl);
+        __m512 vel = _mm512_div_ps(_mm512_sub_ps(yc, yp), step);
+
+        __m512 out = _mm512_add_ps(_mm512_sub_ps(twoY, yp),
+                                   _mm512_mul_ps(_mm512_loadu_ps(tile.rSq + k), lap));
+        out = _mm512_sub_ps(out, _mm512_mul_ps(_mm512_loadu_ps(tile.dampDt + k), vel));
+        _mm512_mask_storeu_ps(yNew + j, m, out);
+    }
+}
+
+static void stencilCommitAvx512(float* y, float* yPrev, float* v, const float* yNew, int n,
+                                float dt) {
+    const __m512 step = _mm512_set1_ps(dt);
+
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 m = (n - i >= 16) ? __mmask16(0xFFFF) : tailMask(n - i);
+
+        __m512 yc = _mm512_maskz_loadu_ps(m, y + i);
+        __m512 yn = _mm512_maskz_loadu_ps(m, yNew + i);
+        _mm512_mask_storeu_ps(v + i, m, _mm512_div_ps(_mm512_sub_ps(yn, yc), step));
+        _mm512_mask_storeu_ps(yPrev + i, m, yc);
+        _mm512_mask_storeu_ps(y + i, m, yn);
+    }
+}
+
+static void stringEnergyAvx512(const float* y, const float* v, int n, float density,
+                               float tension, float dx, float& ke, float& pe) {
+    const __m512 keScale = _mm512_set1_ps(0.5f * density * dx);
+    const __m512 peScale = _mm512_set1_ps(0.5f * tension);
+    const __m512 vdx = _mm512_set1_ps(dx);
+    __m512 keAcc = _mm512_setzero_ps();
+    __m512 peAcc = _mm512_setzero_ps();
+
+    // Kinetic: all n points (masked-off lanes load 0 and add nothing)
+    for (int i = 0; i < n; i += 16) {
+        __mmask16 m = (n - i >= 16) ? __mmask16(0xFFFF) : tailMask(n - i);
+        __m512 vi = _mm512_maskz_loadu_ps(m, v + i);
+        keAcc = _mm512_add_ps(keAcc, _mm512_mul_ps(_mm512_mul_ps(keScale, vi), vi));
+    }
+
+    // Potential: n - 1 segments
+    for (int i = 0; i < n - 1; i += 16) {
+        __mmask16 m = (n - 1 - i >= 16) ? __mmask16(0xFFFF) : tailMask(n - 1 - i);
+        __m512 strain = _mm512_div_ps(
+            _mm512_sub_ps(_mm512_maskz_loadu_ps(m, y + i + 1), _mm512_maskz_loadu_ps(m, y + i)),
+            vdx);
+        __m512 term = _mm512_mul_ps(_mm512_mul_ps(_mm512_mul_ps(peScale, strain), strain), vdx);
+        peAcc = _mm512_add_ps(peAcc, term);
+    }
+
+    ke = _mm512_reduce_add_ps(keAcc);
+    pe = _mm512_reduce_add_ps(peAcc);
+}
+
+const StencilKernels AVX512_STENCIL_KERNELS = {
+    "avx512", stencilInteriorAvx512, stencilCommitAvx512, stringEnergyAvx512,
+    batchInteriorAvx512
+};
@@ -0,0 +1,395 @@
+/**
+ * String Bank - N strings sharing one rigid bridge
+ *
+ * Generalizes SympatheticStrings (physics.h) to sitar/piano-style banks of
+ * strings in a structure-of-arrays layout.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "physics.h"
+#include "temporal_blocking.h"
+
+// ============================================================================
+// String Bank
+// ============================================================================
+//
+// Same physics as SympatheticStrings, generalized to N strings:
+//
+//   y_bridge = sum(T_k * y_want_k) / sum(T_k)
+//
+// Storage is structure-of-arrays: every time level is one contiguous, 64-byte
+// aligned block holding all strings back to back (row k = string k, padded to
+// BANK_STRIDE floats). The three time levels rotate by pointer after each
+// step, so nothing is copied. Velocity is not stored: it is (y - y_prev) / dt.
+//
+// Each string uses the first numPoints[k] floats of its row, sized for its
+// pitch by courantPoints() (physics.h); the sweep aligns rows at the bridge.
+
+constexpr int MAX_BANK_STRINGS = 256;
+constexpr int BANK_ALIGN = 64;                                 // Bytes
+constexpr int BANK_STRIDE = (NUM_POINTS + 15) & ~15;           // Floats per row
+
+class AlignedFloats {
+public:
+    AlignedFloats() = default;
+    AlignedFloats(const AlignedFloats&) = delete;
+    AlignedFloats& operator=(const AlignedFloats&) = delete;
+    ~AlignedFloats() { std::free(ptr); }
+
+    // Zeroed; throws std::bad_alloc and keeps the old block if allocation fails
+    void resize(size_t count) {
+        // aligned_alloc wants a nonzero multiple of the alignment
+        size_t blocks = std::max<size_t>(1, (count * sizeof(float) + BANK_ALIGN - 1) / BANK_ALIGN);
+        size_t bytes = blocks * BANK_ALIGN;
+        float* block = static_cast<float*>(std::aligned_alloc(BANK_ALIGN, bytes));
+        if (!block) throw std::bad_alloc();
+
+        std::memset(block, 0, bytes);
+        std::free(ptr);
+        ptr = block;
+        size = count;
+    }
+
+    void clear() { std::memset(ptr, 0, size * sizeof(float)); }
+
+    float* data() { return ptr; }
+    const float* data() const { return ptr; }
+
+private:
+    float* ptr = nullptr;
+    size_t size = 0;
+};
+
+class StringBank {
+public:
+    int numStrings;
+
+    // Per-string parameters (index = string)
+    std::vector<float> frequency;
+    std::vector<float> tension;
+    std::vector<float> density;
+    std::vector<float> damping;
+    std::vector<float> courantSq;  // (c * dt / dx)^2, cached on frequency change
+    std::vector<int> numPoints;    // Grid points in use, bridge at numPoints - 1
+
+    // Rigid bridge state
+    float bridgeY;
+    float bridgeV;
+    float bridgeStiffness;
+
+    // Simulation
+    float dt;
+    int64_t stepCount;
+    int gridVersion = 0;  // Bumped whenever a string's point count changes
+
+    // Inner loops (scalar / SIMD128 / AVX2 / AVX-512)
+    const StencilKernels* kernels = &activeStencilKernels();
+
+    explicit StringBank(int count) {
+        numStrings = std::max(1, std::min(MAX_BANK_STRINGS, count));
+        dt = 1.0f / (SAMPLE_RATE * OVERSAMPLING);
+
+        for (int b = 0; b < 3; b++) {
+            levels[b].resize(static_cast<size_t>(numStrings) * BANK_STRIDE);
+        }
+
+        frequency.assign(numStrings, 0.0f);
+        tension.assign(numStrings, 0.0f);
+        density.assign(numStrings, 0.001f);
+        damping.assign(numStrings, 0.00001f);
+        courantSq.assign(numStrings, 0.0f);
+        numPoints.assign(numStrings, NUM_POINTS);
+        sweep.resize(numStrings);
+
+        reset();
+    }
+
+    // Row pointers into the current / previous time level
+    float* row(int k) { return levels[cur].data() + static_cast<size_t>(k) * BANK_STRIDE; }
+    float* prevRow(int k) { return levels[prev].data() + static_cast<size_t>(k) * BANK_STRIDE; }
+    const float* row(int k) const { return levels[cur].data() + static_cast<size_t>(k) * BANK_STRIDE; }
+    const float* prevRow(int k) const { return levels[prev].data() + static_cast<size_t>(k) * BANK_STRIDE; }
+
+    // ========================================================================
+    // Pluck a string
+    // ========================================================================
+    void pluck(int stringIndex, float position, float amplitude) {
+        if (stringIndex < 0 || stringIndex >= numStrings) return;
+
+        position = std::max(0.1f, std::min(0.9f, position));
+        amplitude = std::max(0.0f, std::min(1.0f, amplitude));
+
+        float* y = row(stringIndex);
+        float* yp = prevRow(stringIndex);
+
+        // Triangular initial shape, at rest
+        const int N = numPoints[stringIndex];
+        for (int i = 0; i < N; i++) {
+            float x = static_cast<float>(i) / (N - 1);
+            y[i] = (x < position) ? amplitude * x / position
+                                  : amplitude * (1.0f - x) / (1.0f - position);
+            yp[i] = y[i];
+        }
+        y[0] = 0.0f;
+        yp[0] = 0.0f;
+    }
+
+    // ========================================================================
+    // Physics Step
+    // ========================================================================
+    void step(int numSteps = 1) {
+        for (int n = 0; n < numSteps; n++) {
+            stepOnce();
+        }
+    }
+
+    void stepOnce() {
+        float* yCur = levels[cur].data();
+        float* yOld = levels[prev].data();
+        float* yNew = levels[next].data();
+
+        float weightedWant = 0.0f;
+        float totalTension = 0.0f;
+
+        // Interior update, one string at a time over contiguous rows
+        for (int k = 0; k < numStrings; k++) {
+            size_t base = static_cast<size_t>(k) * BANK_STRIDE;
+            const float* y = yCur + base;
+            const float* yp = yOld + base;
+            float* yn = yNew + base;
+            float r_sq = courantSq[k];
+            float d = damping[k];
+            int N = numPoints[k];
+
+            yn[0] = 0.0f;
+            kernels->interior(y, yp, yn, N, r_sq, d, dt);
+
+            weightedWant += tension[k] * bridgeWant(k, y, yp);
+            totalTension += tension[k];
+        }
+
+        // Rigid bridge: tension-weighted equilibrium of all strings
+        solveBridge(weightedWant, totalTension);
+
+        for (int k = 0; k < numStrings; k++) {
+            yNew[static_cast<size_t>(k) * BANK_STRIDE + numPoints[k] - 1] = bridgeY;
+        }
+
+        // Rotate time levels: new becomes current, current becomes previous
+        int oldPrev = prev;
+        prev = cur;
+        cur = next;
+        next = oldPrev;
+
+        stepCount++;
+    }
+
+    // ========================================================================
+    // Fused Substeps (temporal blocking, see temporal_blocking.h)
+    // ========================================================================
+    // Bit-identical to step(numSteps). The three level blocks already rotate,
+    // so the sweep ends by relabelling them; nothing is copied.
+    void stepFused(int numSteps) {
+        if (numSteps <= 0) return;
+
+        float* blocks[3] = { levels[prev].data(), levels[cur].data(), levels[next].data() };
+        int ids[3] = { prev, cur, next };
+
+        for (int k = 0; k < numStrings; k++) {
+            size_t base = static_cast<size_t>(k) * BANK_STRIDE;
+            sweep[k] = {{blocks[0] + base, blocks[1] + base, blocks[2] + base}, numPoints[k],
+                        courantSq[k], damping[k]};
+        }
+
+        sweepSubsteps(sweep.data(), numStrings, numSteps, SWEEP_TILE, *kernels, dt, [&](int level) {
+            float weightedWant = 0.0f;
+            float totalTension = 0.0f;
+            for (int k = 0; k < numStrings; k++) {
+                weightedWant += tension[k] * bridgeWant(k, sweepLevel(sweep[k], level - 1),
+                                                        sweepLevel(sweep[k], level - 2));
+                totalTension += tension[k];
+            }
+            float b = solveBridge(weightedWant, totalTension);
+            for (int k = 0; k < numStrings; k++) {
+                sweepLevel(sweep[k], level)[numPoints[k] - 1] = b;
+            }
+        });
+
+        // Level L ended up in block (L + 1) % 3
+        cur = ids[(numSteps + 1) % 3];
+        prev = ids[numSteps % 3];
+        next = ids[(numSteps + 2) % 3];
+
+        stepCount += numSteps;
+    }
+
+    // What string k wants at its right end (wave equation at the boundary)
+    float bridgeWant(int k, const float* y, const float* yp) const {
+        const int N = numPoints[k];
+        return 2.0f * y[N-1] - yp[N-1]
+             + courantSq[k] * (y[N-2] - 2.0f * y[N-1] + y[N-1])
+             - damping[k] * dt * (y[N-1] - yp[N-1]) / dt;
+    }
+
+    float solveBridge(float weightedWant, float totalTension) {
+        float newBridgeY = weightedWant / totalTension;
+        newBridgeY = bridgeStiffness * newBridgeY + (1.0f - bridgeStiffness) * bridgeY;
+        newBridgeY = std::max(-0.5f, std::min(0.5f, newBridgeY));
+        if (!std::isfinite(newBridgeY)) newBridgeY = 0.0f;
+
+        bridgeV = (newBridgeY - bridgeY) / dt;
+        bridgeY = newBridgeY;
+        return bridgeY;
+    }
+
+    // Runs OVERSAMPLING substeps per frame and sums every string at the
+    // pickup, panned evenly from left (string 0) to right (last string).
+    void renderBlock(int numFrames, float pickupPos, float* outL, float* outR) {
+        pickupPos = std::max(0.0f, std::min(1.0f, pickupPos));
+        float gain = PICKUP_GAIN / std::sqrt(static_cast<float>(numStrings));
+
+        for (int i = 0; i < numFrames; i++) {
+            stepFused(OVERSAMPLING);
+
+            const float* y = levels[cur].data();
+            float left = 0.0f, right = 0.0f;
+            for (int k = 0; k < numStrings; k++) {
+                float pan = numStrings > 1 ? static_cast<float>(k) / (numStrings - 1) : 0.5f;
+                int pickup = std::min(numPoints[k] - 1, static_cast<int>(pickupPos * numPoints[k]));
+                float sample = y[static_cast<size_t>(k) * BANK_STRIDE + pickup] * gain;
+                left += sample * (1.0f - pan);
+                right += sample * pan;
+            }
+            outL[i] = left;
+            outR[i] = right;
+        }
+    }
+
+    // ========================================================================
+    // Energy (computed on request; velocity from the last two time levels)
+    // ========================================================================
+    float getEnergy(int stringIndex) const {
+        if (stringIndex < 0 || stringIndex >= numStrings) return 0.0f;
+
+        const int N = numPoints[stringIndex];
+        float dx = 1.0f / (N - 1);
+        const float* y = row(stringIndex);
+        const float* yp = prevRow(stringIndex);
+        float mu = density[stringIndex];
+        float T = tension[stringIndex];
+        float ke = 0.0f;
+        float pe = 0.0f;
+
+        for (int i = 0; i < N; i++) {
+            float v = (y[i] - yp[i]) / dt;
+            ke += 0.5f * mu * dx * v * v;
+
+            if (i < N - 1) {
+                float strain = (y[i+1] - y[i]) / dx;
+                pe += 0.5f * T * strain * strain * dx;
+            }
+        }
+        return ke + pe;
+    }
+
+    float getTotalEnergy() const {
+        float total = 0.0f;
+        for (int k = 0; k < numStrings; k++) total += getEnergy(k);
+        return total;
+    }
+
+    // ========================================================================
+    // Setters / Getters
+    // ========================================================================
+    void setFrequency(int stringIndex, float freq) {
+        if (stringIndex < 0 || stringIndex >= numStrings) return;
+
+        float f = std::max(50.0f, std::min(1000.0f, freq));
+        float mu = density[stringIndex];
+
+        // Same tuning law as StringState::setFrequency (L = 1)
+        frequency[stringIndex] = f;
+        tension[stringIndex] = 4.0f * mu * f * f;
+        float c = std::sqrt(tension[stringIndex] / mu);
+
+        // Same grid law as SympatheticStrings::fitGrid; the shape is resampled
+        int n = courantPoints(c, 1.0f, dt);
+        if (n != numPoints[stringIndex]) {
+            resampleGrid(row(stringIndex), numPoints[stringIndex], n);
+            resampleGrid(prevRow(stringIndex), numPoints[stringIndex], n);
+            numPoints[stringIndex] = n;
+            gridVersion++;
+        }
+
+        float dx = 1.0f / (n - 1);
+        float r = c * dt / dx;
+        courantSq[stringIndex] = r * r;
+    }
+
+    void setDamping(float d) {
+        float value = std::max(0.0f, std::min(0.01f, d));
+        std::fill(damping.begin(), damping.end(), value);
+    }
+
+    void setStringDamping(int stringIndex, float d) {
+        if (stringIndex < 0 || stringIndex >= numStrings) return;
+        damping[stringIndex] = std::max(0.0f, std::min(0.01f, d));
+    }
+
+    void setBridgeStiffness(float s) {
+        bridgeStiffness = std::max(0.0f, std::min(1.0f, s));
+    }
+
+    std::vector<float> getDisplacement(int stringIndex) const {
+        if (stringIndex < 0 || stringIndex >= numStrings) return {};
+        const float* y = row(stringIndex);
+        return std::vector<float>(y, y + numPoints[stringIndex]);
+    }
+
+    int getNumStrings() const { return numStrings; }
+    int getNumPoints(int stringIndex) const {
+        return (stringIndex >= 0 && stringIndex < numStrings) ? numPoints[stringIndex] : 0;
+    }
+    float getFrequency(int stringIndex) const {
+        return (stringIndex >= 0 && stringIndex < numStrings) ? frequency[stringIndex] : 0.0f;
+    }
+    // Seconds simulated, from the step count (accumulating dt would stall)
+    float getTime() const {
+        return static_cast<float>(static_cast<double>(stepCount) / (static_cast<double>(SAMPLE_RATE) * OVERSAMPLING));
+    }
+    float getBridgeY() const { return bridgeY; }
+    float getBridgeV() const { return bridgeV; }
+    float getBridgeStiffness() const { return bridgeStiffness; }
+
+    // Silences every string and retunes the bank chromatically from C3,
+    // folding back every two octaves to stay inside the 50-1000 Hz range
+    void reset() {
+        for (int b = 0; b < 3; b++) levels[b].clear();
+        cur = 0;
+        prev = 1;
+        next = 2;
+
+        for (int k = 0; k < numStrings; k++) {
+            setFrequency(k, 130.81f * std::pow(2.0f, (k % 24) / 12.0f));
+        }
+
+        bridgeY = 0.0f;
+        bridgeV = 0.0f;
+        bridgeStiffness = 1.0f;
+        stepCount = 0;
+    }
+
+private:
+    AlignedFloats levels[3];
+    std::vector<SweepString> sweep;  // Reused by stepFused
+    int cur = 0;
+    int prev = 1;
+    int next = 2;
+};
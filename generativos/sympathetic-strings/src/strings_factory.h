@@ -0,0 +1,97 @@
+/**
+ * Strings Factory - quality tiers of the FDTD engine, picked at runtime
+ *
+ * BasicSympatheticStrings (physics.h) is a template over its real type and
+ * grid capacity. This header instantiates a fixed set of tiers
+ *
+ *     points:  64, 128, 200, 512
+ *     real:    float (SIMD kernels), double (scalar kernels)
+ *
+ * behind one virtual interface, so a deployment chooses its tier from
+ * configuration while each tier's inner loops still see compile-time array
+ * extents. Only the per-block calls go through the vtable.
+ *
+ *   auto engine = makeStringsEngine(512, true);  // 512 points, double
+ *   engine->pluck(0, 0.3f, 0.5f);
+ *   engine->renderBlock(256, 0.3f, left, right);
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "physics.h"
+
+constexpr int ENGINE_TIERS[] = { 64, 128, 200, 512 };
+
+// Runtime face of one engine instantiation (float API, any internal type)
+class StringsEngine {
+public:
+    virtual ~StringsEngine() = default;
+
+    virtual int capacity() const = 0;          // Grid points per string
+    virtual bool doublePrecision() const = 0;
+
+    virtual void pluck(int stringIndex, float position, float amplitude) = 0;
+    virtual void renderBlock(int numFrames, float pickupPos, float* outL, float* outR) = 0;
+    virtual void step(int numSteps) = 0;
+    virtual void reset() = 0;
+
+    virtual void setString1Frequency(float freq) = 0;
+    virtual void setString2Frequency(float freq) = 0;
+    virtual void setDamping(float d) = 0;
+    virtual void setBridgeStiffness(float s) = 0;
+    virtual void setImplicit(bool enabled) = 0;
+
+    virtual float getEnergy1() = 0;
+    virtual float getEnergy2() = 0;
+    virtual float getBridgeY() = 0;
+    virtual int getString1NumPoints() = 0;
+    virtual int getString2NumPoints() = 0;
+};
+
+template <typename Real, int Points>
+class StringsEngineOf : public StringsEngine {
+public:
+    BasicSympatheticStrings<Real, Points> sim;
+
+    int capacity() const override { return Points; }
+    bool doublePrecision() const override { return sizeof(Real) > sizeof(float); }
+
+    void pluck(int stringIndex, float position, float amplitude) override {
+        sim.pluck(stringIndex, position, amplitude);
+    }
+    void renderBlock(int numFrames, float pickupPos, float* outL, float* outR) override {
+        sim.renderBlock(numFrames, pickupPos, outL, outR);
+    }
+    void step(int numSteps) override { sim.step(numSteps); }
+    void reset() override { sim.reset(); }
+
+    void setString1Frequency(float freq) override { sim.setString1Frequency(freq); }
+    void setString2Frequency(float freq) override { sim.setString2Frequency(freq); }
+    void setDamping(float d) override { sim.setDamping(d); }
+    void setBridgeStiffness(float s) override { sim.setBridgeStiffness(s); }
+    void setImplicit(bool enabled) override { sim.setImplicit(enabled); }
+
+    float getEnergy1() override { return static_cast<float>(sim.getEnergy1()); }
+    float getEnergy2() override { return static_cast<float>(sim.getEnergy2()); }
+    float getBridgeY() override { return static_cast<float>(sim.getBridgeY()); }
+    int getString1NumPoints() override { return sim.getString1NumPoints(); }
+    int getString2NumPoints() override { return sim.getString2NumPoints(); }
+};
+
+template <typename Real>
+inline std::unique_ptr<StringsEngine> makeStringsEngineOf(int points) {
+    if (points <= 64) return std::make_unique<StringsEngineOf<Real, 64>>();
+    if (points <= 128) return std::make_unique<StringsEngineOf<Real, 128>>();
+    if (points <= 200) return std::make_unique<StringsEngineOf<Real, 200>>();
+    if (points <= 512) return std::make_unique<StringsEngineOf<Real, 512>>();
+    return nullptr;
+}
+
+// Smallest tier holding `points` grid points per string, or nullptr above
+// the largest tier
+inline std::unique_ptr<StringsEngine> makeStringsEngine(int points, bool doublePrecision) {
+    return doublePrecision ? makeStringsEngineOf<double>(points)
+                           : makeStringsEngineOf<float>(points);
+}
@@ -0,0 +1,88 @@
+/**
+ * Temporal Blocking - K leapfrog substeps in one tiled sweep
+ *
+ * stepOnce() streams every string through memory once per substep and then
+ * copies the new level back. sweepSubsteps() advances K substeps in one pass
+ * instead, using a skewed (trapezoidal) tiling of space-time:
+ *
+ *     level K     .  .  .  .  [====]
+ *      ...        .  .  [====]
+ *     level 2     .  [====]
+ *     level 1     [====]                 -> tile moves right, bridge at the end
+ *               x=0                  x=L
+ *
+ * Inside a tile, level k covers the points just left of level k-1, so the
+ * three neighbours it needs are still hot in cache. Only three time levels
+ * are kept per string, rotated by index: level L lives in level[(L+1) % 3],
+ * and writing level k overwrites level k-3, which nothing needs any more.
+ *
+ * Strings are aligned at the bridge. As soon as level k reaches the last
+ * interior point of every string, the bridge is solved for level k, before
+ * level k+1 needs it as its right neighbour.
+ *
+ * Every point runs the same kernel on the same inputs as stepOnce(), so the
+ * result is bit-identical to K calls of stepOnce().
+ */
+
+#pragma once
+
+#include <algorithm>
+
+#include "stencil_kernels.h"
+
+constexpr int SWEEP_TILE = 64;  // Points per tile and level
+
+template <typename Real>
+struct BasicSweepString {
+    Real* level[3];   // Level L in level[(L + 1) % 3]; levels -1 and 0 on entry
+    int n;            // Grid points (n - 1 = bridge end)
+    Real rSq;         // Courant number squared
+    Real damping;
+};
+
+using SweepString = BasicSweepString<float>;
+
+// Level L (L >= -1) of a string during a sweep
+template <typename Real>
+inline Real* sweepLevel(const BasicSweepString<Real>& s, int L) {
+    return s.level[(L + 1) % 3];
+}
+
+// Advances `count` strings by K substeps. solveBridge(k) is called once per
+// level, in order; it reads levels k-1 and k-2 at the bridge end of every
+// string and must write level k at index n - 1 of each.
+template <typename Real, typename SolveBridge>
+inline void sweepSubsteps(const BasicSweepString<Real>* strings, int count, int K, int tile,
+                          const BasicStencilKernels<Real>& kernels, Real dt,
+                          SolveBridge solveBridge) {
+    int nMax = 0;
+    for (int s = 0; s < count; s++) nMax = std::max(nMax, strings[s].n);
+
+    int solved = 0;  // Bridge solved for levels 1..solved
+    for (int p0 = 1; solved < K; p0 += tile) {
+        for (int k = 1; k <= K; k++) {
+            // Global span of this level in this tile (strings right-aligned)
+            int lo = p0 - (k - 1);
+            int hi = p0 + tile - (k - 1);
+            if (hi <= 1) break;  // Deeper levels start further left still
+
+            for (int s = 0; s < count; s++) {
+                const BasicSweepString<Real>& str = strings[s];
+                int offset = nMax - str.n;
+                int a = std::max(lo - offset, 1);
+                int b = std::min(hi - offset, str.n - 1);
+                if (a >= b) continue;
+
+                // Interior kernel over [a, b): it updates [1, len-2] of the window
+                kernels.interior(sweepLevel(str, k - 1) + a - 1, sweepLevel(str, k - 2) + a - 1,
+                                 sweepLevel(str, k) + a - 1, b - a + 2,
+                                 str.rSq, str.damping, dt);
+            }
+
+            if (hi >= nMax - 1 && k > solved) {
+                solveBridge(k);
+                solved = k;
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * Tridiagonal - Thomas algorithm for the implicit string scheme
+ *
+ * The implicit θ-scheme (physics.h) solves, every step and for every string,
+ *
+ *     | a  -b            |   | x0 |   | d0 |
+ *     | -b  a  -b        |   | x1 |   | d1 |
+ *     |     .   .   .    | * | .. | = | .. |       a > 2b > 0
+ *     |         -b   a   |   | xm |   | dm |
+ *
+ * The matrix only changes with the string's parameters, so it is factored
+ * once (pivot reciprocals inv[] and multipliers mult[] = b * inv[]) and each
+ * step is one forward and one backward pass:
+ *
+ *     forward:   x[i] = x[i] * inv[i] + mult[i] * x[i-1]
+ *     backward:  x[i] = x[i] + mult[i] * x[i+1]
+ *
+ * The last forward value is already final, which is what lets the bridge be
+ * solved between the two passes (see SympatheticStrings::stepImplicit).
+ *
+ * Both passes are serial recurrences, bound by the latency of one multiply
+ * plus one add per point. Two things shorten that chain:
+ *
+ *   - the passes step two points at a time through the precomputed products
+ *     pair[i] = mult[i] * mult[i+1], so the chain is one multiply-add per
+ *     two points and the in-between point is computed off it
+ *   - the pair versions run two strings' systems in the same loop, two
+ *     independent chains the CPU overlaps
+ */
+
+#pragma once
+
+// Factors the m x m matrix above (no pivoting needed: it is diagonally
+// dominant)
+template <typename Real>
+inline void factorTridiagonal(Real a, Real b, int m, Real* inv, Real* mult, Real* pair) {
+    Real pivot = a;
+    for (int i = 0; i < m; i++) {
+        if (i > 0) pivot = a - b * mult[i-1];
+        inv[i] = 1.0f / pivot;
+        mult[i] = b * inv[i];
+    }
+    for (int i = 0; i + 1 < m; i++) pair[i] = mult[i] * mult[i+1];
+}
+
+// Forward pass over both systems (same m); x holds the right-hand sides on
+// entry
+template <typename Real>
+inline void forwardTridiagonalPair(Real* __restrict x1, const Real* __restrict inv1,
+                                   const Real* __restrict mult1, const Real* __restrict pair1,
+                                   Real* __restrict x2, const Real* __restrict inv2,
+                                   const Real* __restrict mult2, const Real* __restrict pair2,
+                                   int m) {
+    x1[0] *= inv1[0];
+    x2[0] *= inv2[0];
+    int i = 1;
+    for (; i + 1 < m; i += 2) {
+        Real prev1 = x1[i-1], prev2 = x2[i-1];
+        Real a0 = x1[i] * inv1[i], a1 = x1[i+1] * inv1[i+1];
+        Real c0 = x2[i] * inv2[i], c1 = x2[i+1] * inv2[i+1];
+        x1[i] = a0 + mult1[i] * prev1;
+        x2[i] = c0 + mult2[i] * prev2;
+        x1[i+1] = (a1 + mult1[i+1] * a0) + pair1[i] * prev1;
+        x2[i+1] = (c1 + mult2[i+1] * c0) + pair2[i] * prev2;
+    }
+    if (i < m) {
+        x1[i] = x1[i] * inv1[i] + mult1[i] * x1[i-1];
+        x2[i] = x2[i] * inv2[i] + mult2[i] * x2[i-1];
+    }
+}
+
+// Backward pass over both systems, from the (final) last values down
+template <typename Real>
+inline void backTridiagonalPair(Real* __restrict x1, const Real* __restrict mult1,
+                                const Real* __restrict pair1,
+                                Real* __restrict x2, const Real* __restrict mult2,
+                                const Real* __restrict pair2, int m) {
+    int i = m - 2;
+    for (; i >= 1; i -= 2) {
+        Real next1 = x1[i+1], next2 = x2[i+1];
+        Real a0 = x1[i], c0 = x2[i];
+        x1[i] = a0 + mult1[i] * next1;
+        x2[i] = c0 + mult2[i] * next2;
+        x1[i-1] = (x1[i-1] + mult1[i-1] * a0) + pair1[i-1] * next1;
+        x2[i-1] = (x2[i-1] + mult2[i-1] * c0) + pair2[i-1] * next2;
+    }
+    if (i == 0) {
+        x1[0] += mult1[0] * x1[1];
+        x2[0] += mult2[0] * x2[1];
+    }
+}
@@ -0,0 +1,567 @@
+/**
+ * Waveguide Strings - digital waveguide version of the rigid-bridge model
+ *
+ * Each string is a lossless 1D wave equation with a fixed nut, so its
+ * velocity is two travelling waves, each one a delay line:
+ *
+ *      nut                                           bridge
+ *       |  ---- toBridge (N samples) ------------->   |
+ *      -1                                           junction
+ *       |  <--- toNut (M samples) -----------------   |
+ *
+ * The nut reflects with -1 through a first-order allpass that holds the
+ * fractional part of the period, so M + N + allpass = SAMPLE_RATE / f.
+ * Damping is one gain per round trip, the same decay rate as the FDTD term.
+ * The FDTD term damps velocity, not a static deflection, so the gain is
+ * faded to 1 at DC.
+ *
+ * The lines carry velocity rather than displacement: a bridge held away
+ * from zero (bridgeStiffness < 1) leaves a static slope on the strings,
+ * which displacement waves could only represent as ever-growing ramps.
+ * Displacement is the integral of the slope (v- - v+) / c from the nut.
+ *
+ * Bridge junction:
+ *   Each incoming wave a scatters as V - a back towards its nut, where
+ *
+ *     V = 2 * sum(R * a) / sum(R),   R = w * T / c
+ *
+ *   T / c is the string's wave impedance and w = T / (T1 + T2) is the
+ *   weight solveBridge() gives its want, so this is the junction the FDTD
+ *   newBridgeY equilibrium tends to as dx -> 0. solveBridge() moves the
+ *   bridge by bridgeStiffness times the step to equilibrium, so here the
+ *   bridge velocity is bridgeStiffness * V (0 = bridge held, strings
+ *   decoupled). Clamp and NaN guard are the same.
+ *
+ * Everything is O(1) per sample; the pickup displacement is kept as running
+ * sums over the delay lines. The grids in string1 / string2 (and what is
+ * derived from them: energies, forces) are only rebuilt when asked for.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+#include "physics.h"
+
+constexpr int WAVEGUIDE_CAPACITY = 1024;  // Delay line size (> 44100 / 50 Hz + margin)
+constexpr int WAVEGUIDE_MASK = WAVEGUIDE_CAPACITY - 1;
+constexpr float WAVEGUIDE_DC_CUTOFF = 2.0f;  // Hz, below this the nut is lossless
+
+// ============================================================================
+// Delay lines of one string
+// ============================================================================
+// After each sample, toBridge tap k holds the wave at x = (k - 1) / N and
+// toNut tap k the wave at x = 1 - (k - 1) / M (x normalized, 0 = nut).
+struct WaveguideLines {
+    std::array<float, WAVEGUIDE_CAPACITY> toBridge;  // v+, velocity waves
+    std::array<float, WAVEGUIDE_CAPACITY> toNut;     // v-
+
+    int toBridgeDelay = 1;   // N: samples from nut to bridge
+    int toNutDelay = 1;      // M: samples from bridge to nut
+
+    // Fractional delay at the nut (first-order Thiran allpass)
+    float allpassCoef = 0.0f;
+    float allpassIn = 0.0f;
+    float allpassOut = 0.0f;
+
+    float loss = 1.0f;       // Gain per round trip
+    float dcLevel = 0.0f;    // Low-passed wave at the nut, reflected without loss
+    float impedance = 1.0f;  // Junction weight R
+    float waveSpeed = 0.0f;  // Speed the content was written for (0 = none yet)
+
+    // Pickup: sums of the taps between the nut and the pickup point
+    int pickupBridgeTap = 1;   // toBridge taps 1 .. pickupBridgeTap
+    int pickupNutTap = 1;      // toNut taps pickupNutTap .. M + 1
+    float pickupBridgeSum = 0.0f;
+    float pickupNutSum = 0.0f;
+
+    WaveguideLines() {
+        toBridge.fill(0.0f);
+        toNut.fill(0.0f);
+    }
+};
+
+// ============================================================================
+// Waveguide Strings Simulation
+// ============================================================================
+class WaveguideStrings {
+public:
+    // Parameters, energies and the lazily reconstructed y / v grids
+    StringState string1;
+    StringState string2;
+    WaveguideLines lines[2];
+
+    float bridgeY;
+    float bridgeV;
+    float bridgeStiffness;
+
+    // Simulation (one step = one audio sample)
+    float dt;
+    int64_t stepCount;
+    int writePos = 0;        // Shared by every delay line
+    int pickupIndex = -1;    // Grid point the pickup sums are set up for
+    float dcCoef = 1.0f - std::exp(-2.0f * PI * WAVEGUIDE_DC_CUTOFF / SAMPLE_RATE);
+
+    HistoryRing energy1History{HISTORY_LENGTH};
+    HistoryRing energy2History{HISTORY_LENGTH};
+    HistoryRing bridgeHistory{HISTORY_LENGTH};
+    int historyInterval = HISTORY_INTERVAL;
+
+    // Energy sums over the reconstructed grid
+    const StencilKernels* kernels = &activeStencilKernels();
+
+    bool energyDirty = false;
+    bool displacementDirty = false;
+    bool energyDiagnostics = false;
+    float maxTotalEnergy = 0.0f;
+
+    WaveguideStrings() {
+        dt = 1.0f / SAMPLE_RATE;
+        stepCount = 0;
+
+        bridgeY = 0.0f;
+        bridgeV = 0.0f;
+        bridgeStiffness = 1.0f;
+
+        // Default: C4 and G4 (perfect fifth, ratio 3:2)
+        string1.setFrequency(261.63f);
+        string2.setFrequency(392.00f);
+        tuneLines();
+    }
+
+    StringState& stringAt(int s) { return s == 0 ? string1 : string2; }
+
+    // ========================================================================
+    // Delay line access
+    // ========================================================================
+    float& at(std::array<float, WAVEGUIDE_CAPACITY>& line, int k) {
+        return line[(writePos - k) & WAVEGUIDE_MASK];
+    }
+
+    // Value written k samples ago (k >= 1), linearly interpolated
+    float tap(const std::array<float, WAVEGUIDE_CAPACITY>& line, float k) const {
+        int k0 = static_cast<int>(k);
+        float frac = k - k0;
+        float a = line[(writePos - k0) & WAVEGUIDE_MASK];
+        float b = line[(writePos - k0 - 1) & WAVEGUIDE_MASK];
+        return a + frac * (b - a);
+    }
+
+    // ========================================================================
+    // Tuning
+    // ========================================================================
+    // Delays, allpass, loss and junction weights from the string parameters.
+    // Wave content is resampled (and rescaled for the new wave speed) so the
+    // strings keep their shape.
+    void tuneLines() {
+        float totalTension = string1.tension + string2.tension;
+
+        for (int s = 0; s < 2; s++) {
+            StringState& str = stringAt(s);
+            WaveguideLines& w = lines[s];
+
+            int oldN = w.toBridgeDelay;
+            int oldM = w.toNutDelay;
+            float scale = (w.waveSpeed > 0.0f) ? str.waveSpeed / w.waveSpeed : 1.0f;
+            w.waveSpeed = str.waveSpeed;
+
+            // Period in samples: integer part in the lines, 0.618..1.618 in the
+            // allpass (keeps its coefficient small and its delay flat)
+            float period = SAMPLE_RATE / str.frequency;
+            int whole = static_cast<int>(period - 0.618f);
+            float frac = period - whole;
+            w.toNutDelay = whole / 2;
+            w.toBridgeDelay = whole - w.toNutDelay;
+            w.allpassCoef = (1.0f - frac) / (1.0f + frac);
+
+            // FDTD damping is per substep: decay rate damping / substep / 2
+            float substep = 1.0f / (SAMPLE_RATE * OVERSAMPLING);
+            float sigma = 0.5f * str.damping / substep;
+            w.loss = std::exp(-sigma * period * dt);
+
+            w.impedance = (str.tension / totalTension) * str.tension / str.waveSpeed;
+
+            if (w.toBridgeDelay != oldN || w.toNutDelay != oldM || scale != 1.0f) {
+                resampleLine(w.toBridge, oldN, w.toBridgeDelay, scale);
+                resampleLine(w.toNut, oldM, w.toNutDelay, scale);
+                w.dcLevel *= scale;
+            }
+        }
+
+        pickupIndex = -1;
+        markEnergyDirty();
+    }
+
+    // Stretches taps 1..oldDelay+1 onto 1..newDelay+1 (same positions along
+    // the string) and scales them: same slope at a new wave speed
+    void resampleLine(std::array<float, WAVEGUIDE_CAPACITY>& line, int oldDelay, int newDelay,
+                      float scale) {
+        std::array<float, WAVEGUIDE_CAPACITY> scratch;
+        for (int k = 1; k <= newDelay + 1; k++) {
+            float pos = static_cast<float>(k - 1) / newDelay;
+            scratch[k] = scale * tap(line, 1.0f + pos * oldDelay);
+        }
+        for (int k = 1; k <= newDelay + 1; k++) {
+            at(line, k) = scratch[k];
+        }
+    }
+
+    // ========================================================================
+    // Pluck a string
+    // ========================================================================
+    // Same triangular shape as SympatheticStrings::pluck(), at rest, on top
+    // of the line from the nut to the bridge's current position. The other
+    // string is untouched.
+    void pluck(int stringIndex, float position, float amplitude) {
+        int s = (stringIndex == 0) ? 0 : 1;
+        const StringState& str = stringAt(s);
+        WaveguideLines& w = lines[s];
+
+        position = std::max(0.1f, std::min(0.9f, position));
+        amplitude = std::max(0.0f, std::min(1.0f, amplitude));
+
+        // At rest, v+ = -v- and (v- - v+) / c is the slope
+        float c = str.waveSpeed;
+        auto halfSlopeSpeed = [&](float x) {
+            float slope = (x < position ? amplitude / position : -amplitude / (1.0f - position))
+                        + bridgeY / str.length;
+            return 0.5f * c * slope;
+        };
+
+        for (int k = 1; k <= w.toBridgeDelay + 1; k++) {
+            float x = static_cast<float>(k - 1) / w.toBridgeDelay;
+            at(w.toBridge, k) = -halfSlopeSpeed(x);
+        }
+        for (int k = 1; k <= w.toNutDelay + 1; k++) {
+            float x = 1.0f - static_cast<float>(k - 1) / w.toNutDelay;
+            at(w.toNut, k) = halfSlopeSpeed(x);
+        }
+        w.allpassIn = 0.0f;
+        w.allpassOut = 0.0f;
+        w.dcLevel = 0.5f * c * bridgeY / str.length;  // The triangle's slope averages to 0
+
+        pickupIndex = -1;
+        markEnergyDirty();
+    }
+
+    // ========================================================================
+    // Physics Step (one audio sample per step)
+    // ========================================================================
+    void step(int numSteps = 1) {
+        for (int n = 0; n < numSteps; n++) {
+            stepOnce();
+        }
+    }
+
+    // ========================================================================
+    // Block Rendering
+    // ========================================================================
+    // Same pickup, gain and stereo mix as SympatheticStrings::renderBlock()
+    void renderBlock(int numFrames, float pickupPos, float* outL, float* outR) {
+        pickupPos = std::max(0.0f, std::min(1.0f, pickupPos));
+        int pickup = std::min(NUM_POINTS - 1, static_cast<int>(pickupPos * NUM_POINTS));
+
+        // Running sums are recomputed once per block so rounding cannot drift
+        pickupIndex = -1;
+        setPickup(pickup);
+
+        for (int i = 0; i < numFrames; i++) {
+            stepOnce();
+
+            float s1 = pickupDisplacement(0) * PICKUP_GAIN;
+            float s2 = pickupDisplacement(1) * PICKUP_GAIN;
+
+            outL[i] = s1 * STEREO_MIX + s2 * (1.0f - STEREO_MIX);
+            outR[i] = s1 * (1.0f - STEREO_MIX) + s2 * STEREO_MIX;
+        }
+    }
+
+    void stepOnce() {
+        float arriving[2];
+        float atNut[2];
+        for (int s = 0; s < 2; s++) {
+            arriving[s] = at(lines[s].toBridge, lines[s].toBridgeDelay);
+            atNut[s] = at(lines[s].toNut, lines[s].toNutDelay);
+        }
+
+        float v = solveJunction(arriving[0], arriving[1]);
+
+        for (int s = 0; s < 2; s++) {
+            WaveguideLines& w = lines[s];
+
+            // Scattered back towards the nut, moving with the bridge
+            w.toNut[writePos] = v - arriving[s];
+
+            // Nut: fractional delay, loss (none at DC) and inversion
+            float delayed = w.allpassCoef * atNut[s] + w.allpassIn - w.allpassCoef * w.allpassOut;
+            w.allpassIn = atNut[s];
+            w.allpassOut = delayed;
+            w.dcLevel += dcCoef * (delayed - w.dcLevel);
+            w.toBridge[writePos] = -(w.loss * delayed + (1.0f - w.loss) * w.dcLevel);
+        }
+        writePos = (writePos + 1) & WAVEGUIDE_MASK;
+
+        // Slide the pickup sums: one tap enters and one leaves each window
+        if (pickupIndex >= 0) {
+            for (int s = 0; s < 2; s++) {
+                WaveguideLines& w = lines[s];
+                w.pickupBridgeSum += at(w.toBridge, 1) - at(w.toBridge, w.pickupBridgeTap + 1);
+                w.pickupNutSum += at(w.toNut, w.pickupNutTap) - at(w.toNut, w.toNutDelay + 2);
+            }
+        }
+
+        markEnergyDirty();
+
+        stepCount++;
+
+        if (stepCount % historyInterval == 0) {
+            recordHistory();
+        }
+    }
+
+    // Impedance-weighted junction velocity, scaled by the stiffness like the
+    // blend in SympatheticStrings::solveBridge(); integrates the bridge and
+    // returns its velocity
+    float solveJunction(float a1, float a2) {
+        const WaveguideLines& w1 = lines[0];
+        const WaveguideLines& w2 = lines[1];
+        float junctionV = 2.0f * (w1.impedance * a1 + w2.impedance * a2)
+                        / (w1.impedance + w2.impedance);
+
+        float newBridgeY = bridgeY + bridgeStiffness * junctionV * dt;
+
+        newBridgeY = std::max(-0.5f, std::min(0.5f, newBridgeY));
+        if (!std::isfinite(newBridgeY)) newBridgeY = 0.0f;
+
+        bridgeV = (newBridgeY - bridgeY) / dt;
+        bridgeY = newBridgeY;
+        return bridgeV;
+    }
+
+    // ========================================================================
+    // Pickup
+    // ========================================================================
+    // Sets up the tap windows between the nut and grid point `index` and
+    // sums them from scratch
+    void setPickup(int index) {
+        if (index == pickupIndex) return;
+        pickupIndex = index;
+
+        float x = static_cast<float>(index) / (NUM_POINTS - 1);
+        for (int s = 0; s < 2; s++) {
+            WaveguideLines& w = lines[s];
+            w.pickupBridgeTap = 1 + static_cast<int>(std::lround(x * w.toBridgeDelay));
+            w.pickupNutTap = 1 + static_cast<int>(std::lround((1.0f - x) * w.toNutDelay));
+
+            w.pickupBridgeSum = 0.0f;
+            for (int k = 1; k <= w.pickupBridgeTap; k++) w.pickupBridgeSum += at(w.toBridge, k);
+            w.pickupNutSum = 0.0f;
+            for (int k = w.pickupNutTap; k <= w.toNutDelay + 1; k++) w.pickupNutSum += at(w.toNut, k);
+        }
+    }
+
+    // Trapezoid integral of (v- - v+) / c from the nut to the pickup
+    float pickupDisplacement(int s) {
+        WaveguideLines& w = lines[s];
+        const StringState& str = stringAt(s);
+
+        float bridgeSide = w.pickupBridgeSum
+                         - 0.5f * (at(w.toBridge, 1) + at(w.toBridge, w.pickupBridgeTap));
+        float nutSide = w.pickupNutSum
+                      - 0.5f * (at(w.toNut, w.pickupNutTap) + at(w.toNut, w.toNutDelay + 1));
+
+        return str.length / str.waveSpeed
+             * (nutSide / w.toNutDelay - bridgeSide / w.toBridgeDelay);
+    }
+
+    // ========================================================================
+    // Grid reconstruction (lazy)
+    // ========================================================================
+    // v = v+ + v-; y integrates the slope from the nut and is then levelled
+    // so that it ends exactly on the bridge
+    void updateDisplacement() {
+        if (!displacementDirty) return;
+
+        const int N = NUM_POINTS;
+        for (int s = 0; s < 2; s++) {
+            StringState& str = stringAt(s);
+            const WaveguideLines& w = lines[s];
+            float dx = str.length / (N - 1);
+
+            float prevSlope = 0.0f;
+            for (int i = 0; i < N; i++) {
+                float x = static_cast<float>(i) / (N - 1);
+                float vPlus = tap(w.toBridge, 1.0f + x * w.toBridgeDelay);
+                float vMinus = tap(w.toNut, 1.0f + (1.0f - x) * w.toNutDelay);
+                float slope = (vMinus - vPlus) / str.waveSpeed;
+
+                str.v[i] = vPlus + vMinus;
+                str.y[i] = (i == 0) ? 0.0f : str.y[i-1] + 0.5f * (prevSlope + slope) * dx;
+                prevSlope = slope;
+            }
+
+            float error = bridgeY - str.y[N-1];
+            for (int i = 0; i < N; i++) {
+                str.y[i] += error * static_cast<float>(i) / (N - 1);
+            }
+            str.v[0] = 0.0f;
+            str.v[N-1] = bridgeV;
+
+            str.forceOnBridge = -str.tension * (str.y[N-1] - str.y[N-2]) / dx;
+        }
+
+        displacementDirty = false;
+    }
+
+    // ========================================================================
+    // Energy
+    // ========================================================================
+    void markEnergyDirty() {
+        energyDirty = true;
+        displacementDirty = true;
+        if (energyDiagnostics) updateEnergy();
+    }
+
+    void updateEnergy() {
+        if (!energyDirty) return;
+
+        updateDisplacement();
+        computeEnergy(string1);
+        computeEnergy(string2);
+        energyDirty = false;
+
+        maxTotalEnergy = std::max(maxTotalEnergy, string1.totalEnergy + string2.totalEnergy);
+    }
+
+    // Opt-in energy on every sample (reconstructs the grid each time)
+    void setEnergyDiagnostics(bool enabled) {
+        energyDiagnostics = enabled;
+        maxTotalEnergy = 0.0f;
+        updateEnergy();
+    }
+
+    void computeEnergy(StringState& s) {
+        float dx = s.length / (NUM_POINTS - 1);
+        float ke, pe;
+        kernels->energy(s.y.data(), s.v.data(), NUM_POINTS, s.density, s.tension, dx, ke, pe);
+
+        s.kineticEnergy = ke;
+        s.potentialEnergy = pe;
+        s.totalEnergy = ke + pe;
+    }
+
+    void recordHistory() {
+        updateEnergy();
+
+        energy1History.push(string1.totalEnergy);
+        energy2History.push(string2.totalEnergy);
+        bridgeHistory.push(bridgeY);
+    }
+
+    // Capacity in samples and decimation in steps (audio samples) per sample
+    void setHistoryConfig(int capacity, int interval) {
+        size_t cap = static_cast<size_t>(std::max(2, capacity));
+        energy1History.setCapacity(cap);
+        energy2History.setCapacity(cap);
+        bridgeHistory.setCapacity(cap);
+        historyInterval = std::max(1, interval);
+    }
+
+    // ========================================================================
+    // Setters
+    // ========================================================================
+    void setString1Frequency(float freq) {
+        string1.setFrequency(std::max(50.0f, std::min(1000.0f, freq)));
+        tuneLines();
+    }
+
+    void setString2Frequency(float freq) {
+        string2.setFrequency(std::max(50.0f, std::min(1000.0f, freq)));
+        tuneLines();
+    }
+
+    void setDamping(float d) {
+        float damping = std::max(0.0f, std::min(0.01f, d));
+        string1.damping = damping;
+        string2.damping = damping;
+        tuneLines();
+    }
+
+    void setBridgeStiffness(float s) {
+        bridgeStiffness = std::max(0.0f, std::min(1.0f, s));
+    }
+
+    // ========================================================================
+    // Getters
+    // ========================================================================
+    std::vector<float> getString1Displacement() {
+        updateDisplacement();
+        return std::vector<float>(string1.y.begin(), string1.y.end());
+    }
+
+    std::vector<float> getString2Displacement() {
+        updateDisplacement();
+        return std::vector<float>(string2.y.begin(), string2.y.end());
+    }
+
+    std::vector<float> getString1Velocity() {
+        updateDisplacement();
+        return std::vector<float>(string1.v.begin(), string1.v.end());
+    }
+
+    std::vector<float> getString2Velocity() {
+        updateDisplacement();
+        return std::vector<float>(string2.v.begin(), string2.v.end());
+    }
+
+    std::vector<float> getEnergy1History() { return energy1History.toVector(); }
+    std::vector<float> getEnergy2History() { return energy2History.toVector(); }
+    std::vector<float> getBridgeHistory() { return bridgeHistory.toVector(); }
+    int getHistoryCapacity() { return static_cast<int>(energy1History.capacity()); }
+    int getHistoryInterval() { return historyInterval; }
+
+    // Seconds simulated, from the step count (accumulating dt would stall)
+    float getTime() const {
+        return static_cast<float>(static_cast<double>(stepCount) / SAMPLE_RATE);
+    }
+    float getEnergy1() { updateEnergy(); return string1.totalEnergy; }
+    float getEnergy2() { updateEnergy(); return string2.totalEnergy; }
+    float getKinetic1() { updateEnergy(); return string1.kineticEnergy; }
+    float getKinetic2() { updateEnergy(); return string2.kineticEnergy; }
+    float getPotential1() { updateEnergy(); return string1.potentialEnergy; }
+    float getPotential2() { updateEnergy(); return string2.potentialEnergy; }
+    float getTotalEnergy() { updateEnergy(); return string1.totalEnergy + string2.totalEnergy; }
+    float getMaxTotalEnergy() { updateEnergy(); return maxTotalEnergy; }
+    bool getEnergyDiagnostics() { return energyDiagnostics; }
+    float getBridgeY() { return bridgeY; }
+    float getBridgeV() { return bridgeV; }
+    float getForce1() { updateDisplacement(); return string1.forceOnBridge; }
+    float getForce2() { updateDisplacement(); return string2.forceOnBridge; }
+    float getString1Frequency() { return string1.frequency; }
+    float getString2Frequency() { return string2.frequency; }
+    float getBridgeStiffness() { return bridgeStiffness; }
+
+    void reset() {
+        string1 = StringState();
+        string2 = StringState();
+        string1.setFrequency(261.63f);
+        string2.setFrequency(392.00f);
+        lines[0] = WaveguideLines();
+        lines[1] = WaveguideLines();
+        bridgeY = 0.0f;
+        bridgeV = 0.0f;
+        bridgeStiffness = 1.0f;
+        stepCount = 0;
+        writePos = 0;
+        maxTotalEnergy = 0.0f;
+        energy1History.clear();
+        energy2History.clear();
+        bridgeHistory.clear();
+        tuneLines();
+        updateEnergy();
+    }
+};